@@ -0,0 +1,255 @@
+#include "BenchReport.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <sstream>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+using namespace std;
+
+// average of all samples
+double SampleStats::mean() const {
+    if (samples.empty()) return 0.0;
+    double total = 0.0;
+    for (double sample : samples) total += sample;
+    return total / samples.size();
+}
+
+// slowest sample
+double SampleStats::max() const {
+    if (samples.empty()) return 0.0;
+    return *max_element(samples.begin(), samples.end());
+}
+
+// nearest-rank percentile, sorts a copy so samples keep their order
+double SampleStats::percentile(double p) const {
+    if (samples.empty()) return 0.0;
+    vector<double> sorted(samples);
+    sort(sorted.begin(), sorted.end());
+    size_t rank = static_cast<size_t>(ceil(p / 100.0 * sorted.size()));
+    rank = std::max<size_t>(rank, 1);
+    return sorted[std::min(rank, sorted.size()) - 1];
+}
+
+// constructor: writes into out
+JsonWriter::JsonWriter(ostream& out) : out(out) {
+    this->out << fixed << setprecision(3);
+}
+
+// opens an object, named unless it is the top level one
+void JsonWriter::beginObject(const string& key) {
+    if (!firstInObject.empty()) {
+        writeKey(key);
+    }
+    out << "{";
+    firstInObject.push_back(true);
+}
+
+// closes the innermost object
+void JsonWriter::endObject() {
+    bool empty = firstInObject.back();
+    firstInObject.pop_back();
+    if (!empty) {
+        out << "\n" << string(firstInObject.size() * 2, ' ');
+    }
+    out << "}";
+    if (firstInObject.empty()) {
+        out << "\n";
+    }
+}
+
+// writes a number member
+void JsonWriter::value(const string& key, double number) {
+    writeKey(key);
+    out << (isfinite(number) ? number : 0.0);
+}
+
+// writes an integer member (counts and byte sizes)
+void JsonWriter::value(const string& key, uint64_t number) {
+    writeKey(key);
+    out << number;
+}
+
+// writes a string member
+void JsonWriter::value(const string& key, const string& text) {
+    writeKey(key);
+    out << "\"" << escape(text) << "\"";
+}
+
+// comma (unless first), newline, indentation and the quoted key
+void JsonWriter::writeKey(const string& key) {
+    if (!firstInObject.back()) {
+        out << ",";
+    }
+    firstInObject.back() = false;
+    out << "\n" << string(firstInObject.size() * 2, ' ') << "\"" << escape(key) << "\": ";
+}
+
+// escapes quotes, backslashes and control characters
+string JsonWriter::escape(const string& text) {
+    string escaped;
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+            escaped += c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20) {
+            escaped += ' ';
+        }
+        else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+// tiny reader for the reports written above: objects, strings and numbers (arrays, true/false/null are skipped)
+class JsonFlattener {
+public:
+    JsonFlattener(const string& text, map<string, double>& result) : text(text), result(result) {}
+
+    void parse() { parseValue(""); }
+
+private:
+    const string& text;
+    map<string, double>& result;
+    size_t pos = 0;
+
+    void skipSpace() {
+        while (pos < text.size() && isspace(static_cast<unsigned char>(text[pos]))) pos++;
+    }
+
+    string parseString() {
+        string value;
+        pos++;                                    // opening quote
+        while (pos < text.size() && text[pos] != '"') {
+            if (text[pos] == '\\' && pos + 1 < text.size()) pos++;
+            value += text[pos++];
+        }
+        pos++;                                    // closing quote
+        return value;
+    }
+
+    void parseValue(const string& path) {
+        skipSpace();
+        if (pos >= text.size()) return;
+
+        char c = text[pos];
+        if (c == '{') {
+            pos++;
+            skipSpace();
+            while (pos < text.size() && text[pos] != '}') {
+                string key = parseString();
+                skipSpace();
+                pos++;                            // ':'
+                parseValue(path.empty() ? key : path + "." + key);
+                skipSpace();
+                if (pos < text.size() && text[pos] == ',') pos++;
+                skipSpace();
+            }
+            pos++;
+        }
+        else if (c == '[') {
+            int depth = 0;                        // reports don't use arrays, step over them
+            do {
+                if (text[pos] == '[') depth++;
+                else if (text[pos] == ']') depth--;
+                pos++;
+            } while (pos < text.size() && depth > 0);
+        }
+        else if (c == '"') {
+            parseString();
+        }
+        else {
+            const char* start = text.c_str() + pos;
+            char* end = nullptr;
+            double number = strtod(start, &end);
+            if (end == start) {
+                while (pos < text.size() && isalpha(static_cast<unsigned char>(text[pos]))) pos++; // true/false/null
+                return;
+            }
+            pos += end - start;
+            result[path] = number;
+        }
+    }
+};
+
+// flattens a report into path -> number
+map<string, double> flattenJsonNumbers(const string& json) {
+    map<string, double> result;
+    JsonFlattener(json, result).parse();
+    return result;
+}
+
+// whether a key names something where more is worse
+static bool isCostMetric(const string& key) {
+    static const char* suffixes[] = { "_ms", "_bytes", "_reads", "_writes", "_uploads", "_count", "_ns", "_allocs" };
+    for (const char* suffix : suffixes) {
+        string s(suffix);
+        if (key.size() >= s.size() && key.compare(key.size() - s.size(), s.size(), s) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// prints every cost metric that got worse than the baseline allows
+int compareWithBaseline(const map<string, double>& current, const map<string, double>& baseline,
+    double tolerance, double minDeltaMs, ostream& log) {
+    int regressions = 0;
+    for (const auto& entry : baseline) {
+        const string& key = entry.first;
+        if (!isCostMetric(key)) continue;
+
+        auto it = current.find(key);
+        if (it == current.end()) {
+            log << "missing   " << key << " (baseline " << entry.second << ")\n";
+            continue;
+        }
+
+        double before = entry.second;
+        double after = it->second;
+        bool isTiming = key.size() >= 3 && key.compare(key.size() - 3, 3, "_ms") == 0;
+        double delta = after - before;
+        if (delta <= before * tolerance || (isTiming && delta < minDeltaMs)) continue;
+
+        regressions++;
+        log << "REGRESSED " << key << ": " << before << " -> " << after;
+        if (before > 0.0) {
+            ostringstream percent;
+            percent << fixed << setprecision(1) << (delta / before * 100.0);
+            log << " (+" << percent.str() << "%)";
+        }
+        log << "\n";
+    }
+    return regressions;
+}
+
+// peak memory of the process, working set on Windows, max RSS elsewhere
+uint64_t getPeakResidentBytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return static_cast<uint64_t>(counters.PeakWorkingSetSize);
+    }
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return static_cast<uint64_t>(usage.ru_maxrss);           // already bytes
+#else
+    return static_cast<uint64_t>(usage.ru_maxrss) * 1024;    // kilobytes
+#endif
+#endif
+}
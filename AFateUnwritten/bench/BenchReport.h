@@ -0,0 +1,60 @@
+#ifndef BENCH_REPORT_H
+#define BENCH_REPORT_H
+
+// Standard Library Includes
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// handles: the measuring and reporting side of the benchmark executables
+// timings are collected into SampleStats, written out as JSON with JsonWriter, and a stored
+// baseline can be compared against the current run to flag regressions
+
+// a set of timing samples (milliseconds) with the usual summary numbers
+class SampleStats {
+public:
+    void add(double ms) { samples.push_back(ms); }
+    size_t count() const { return samples.size(); }
+    double mean() const;                          // average of all samples (0 if empty)
+    double max() const;                           // slowest sample (0 if empty)
+    double percentile(double p) const;            // p in [0, 100], nearest-rank (0 if empty)
+
+private:
+    std::vector<double> samples;
+};
+
+// minimal streaming JSON writer: nested objects of numbers and strings, pretty printed
+class JsonWriter {
+public:
+    explicit JsonWriter(std::ostream& out);
+
+    void beginObject(const std::string& key = "");   // opens {...}, key is ignored at the top level
+    void endObject();
+    void value(const std::string& key, double number);
+    void value(const std::string& key, std::uint64_t number);
+    void value(const std::string& key, const std::string& text);
+
+private:
+    std::ostream& out;
+    std::vector<bool> firstInObject;                  // one entry per open object: nothing written into it yet
+
+    void writeKey(const std::string& key);            // separator, indentation and "key":
+    static std::string escape(const std::string& text);
+};
+
+// -- baseline comparison --
+// every number in a report flattened to "path.to.value" -> value (strings are skipped)
+std::map<std::string, double> flattenJsonNumbers(const std::string& json);
+
+// compares cost metrics (keys ending in _ms, _bytes, _reads, _writes, _uploads, _count, _ns, _allocs) and prints every
+// one that grew by more than tolerance (0.10 = 10%), _ms timings also have to grow by at least minDeltaMs to count as noise-free
+// returns how many metrics regressed
+int compareWithBaseline(const std::map<std::string, double>& current, const std::map<std::string, double>& baseline,
+    double tolerance, double minDeltaMs, std::ostream& log);
+
+// -- process --
+std::uint64_t getPeakResidentBytes();                 // peak working set / max RSS of this process so far
+
+#endif
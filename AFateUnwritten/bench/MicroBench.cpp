@@ -0,0 +1,315 @@
+// microbenchmarks for the text, layout and quiz paths that dominate frame time, each measured in isolation
+// every case runs in batches of at least --min-batch-ms, the reported time is the median batch, allocations
+// are counted by replacing the global operator new for this executable
+//
+// usage: AFateUnwrittenMicroBench [--filter text] [--repeats 7] [--min-batch-ms 20]
+//                                 [--out results.json] [--baseline baseline.json] [--tolerance 0.10]
+// exit code: 0 = ok, 1 = regressed against the baseline, 2 = setup failed or bad arguments
+// note: runs from the project directory (resources/ is relative). allocations made inside the SFML DLLs use
+// their own heap and are not seen, so allocs/op counts what the game's own code allocates
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "BenchReport.h"
+#include "NullRenderTarget.h"
+#include "Input.h"
+#include "GameClock.h"
+#include "LoadResources.h"
+#include "TextManager.h"
+#include "Dialogue.h"
+#include "QuestionHandler.h"
+#include "Button.h"
+#include "GifAnimator.h"
+#include "LionNarrative.h"
+#include "ScarecrowNarrative.h"
+#include "TinmanNarrative.h"
+#include "OutroNarrative.h"
+#include "Lion.h"
+#include "Tinman.h"
+
+using namespace std;
+using namespace sf;
+
+// -- allocation counting --
+static atomic<uint64_t> allocationCount{ 0 };
+
+void* operator new(size_t size) {
+    allocationCount.fetch_add(1, memory_order_relaxed);
+    if (void* memory = malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+    free(memory);
+}
+
+namespace {
+
+// one measured case
+struct CaseResult {
+    string name;
+    double nsPerOp = 0.0;                    // median over the batches
+    double minNsPerOp = 0.0;                 // fastest batch
+    double allocsPerOp = 0.0;                // over all batches
+    uint64_t opsPerBatch = 0;
+};
+
+// keeps the compiler from dropping work whose result is unused
+const void* volatile keepSink = nullptr;
+
+template <typename T>
+void keep(const T& value) {
+    keepSink = &value;
+}
+
+// times op: finds a batch size that takes at least minBatchMs, then runs repeats batches
+template <typename Op>
+CaseResult measure(const string& name, int repeats, double minBatchMs, Op op) {
+    using Clock = chrono::steady_clock;
+    op();  // warm up (first-use allocations, glyph pages)
+
+    uint64_t batch = 1;
+    while (true) {
+        auto start = Clock::now();
+        for (uint64_t i = 0; i < batch; ++i) op();
+        double ms = chrono::duration<double, milli>(Clock::now() - start).count();
+        if (ms >= minBatchMs || batch >= (1ull << 30)) break;
+        batch = ms > 0.0 ? max(batch * 2, static_cast<uint64_t>(batch * minBatchMs / ms * 1.1)) : batch * 10;
+    }
+
+    vector<double> nsPerOp;
+    uint64_t allocationsBefore = allocationCount.load();
+    for (int r = 0; r < repeats; ++r) {
+        auto start = Clock::now();
+        for (uint64_t i = 0; i < batch; ++i) op();
+        double ns = chrono::duration<double, nano>(Clock::now() - start).count();
+        nsPerOp.push_back(ns / batch);
+    }
+    uint64_t allocations = allocationCount.load() - allocationsBefore;
+
+    sort(nsPerOp.begin(), nsPerOp.end());
+    CaseResult result;
+    result.name = name;
+    result.nsPerOp = nsPerOp[nsPerOp.size() / 2];
+    result.minNsPerOp = nsPerOp.front();
+    result.allocsPerOp = static_cast<double>(allocations) / (static_cast<double>(batch) * repeats);
+    result.opsPerBatch = batch;
+    return result;
+}
+
+// longest line of a narrative (the worst case for wrapping)
+string longestLine(const vector<NarrativeStore::Sequence>& narratives) {
+    string longest;
+    for (const auto& narrative : narratives) {
+        for (const auto& line : narrative) {
+            if (line.text.size() > longest.size()) longest = string(line.text);
+        }
+    }
+    return longest;
+}
+
+bool matchesFilter(const string& name, const string& filter) {
+    return filter.empty() || name.find(filter) != string::npos;
+}
+
+void printTable(const vector<CaseResult>& results) {
+    cout << left << setw(28) << "case" << right << setw(14) << "ns/op" << setw(14) << "min ns/op"
+        << setw(12) << "allocs/op" << setw(12) << "ops/batch" << "\n";
+    cout << fixed;
+    for (const CaseResult& result : results) {
+        cout << left << setw(28) << result.name << right << setprecision(1) << setw(14) << result.nsPerOp
+            << setw(14) << result.minNsPerOp << setprecision(2) << setw(12) << result.allocsPerOp
+            << setw(12) << result.opsPerBatch << "\n";
+    }
+}
+
+void writeReport(ostream& out, const vector<CaseResult>& results, int repeats, double minBatchMs) {
+    JsonWriter json(out);
+    json.beginObject();
+    json.value("benchmark", string("micro"));
+    json.value("repeats", static_cast<uint64_t>(repeats));
+    json.value("min_batch_window", minBatchMs);  // a setting, not a cost: no cost suffix, so the baseline check skips it
+    json.beginObject("cases");
+    for (const CaseResult& result : results) {
+        json.beginObject(result.name);
+        json.value("op_ns", result.nsPerOp);
+        json.value("op_min_ns", result.minNsPerOp);
+        json.value("op_allocs", result.allocsPerOp);
+        json.value("ops_per_batch", result.opsPerBatch);
+        json.endObject();
+    }
+    json.endObject();
+    json.endObject();
+}
+
+bool readFile(const string& path, string& contents) {
+    ifstream file(path);
+    if (!file.is_open()) return false;
+    stringstream buffer;
+    buffer << file.rdbuf();
+    contents = buffer.str();
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    string filter;
+    string outPath;
+    string baselinePath;
+    int repeats = 7;
+    double minBatchMs = 20.0;
+    double tolerance = 0.10;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--filter" && hasValue) filter = argv[++i];
+        else if (arg == "--repeats" && hasValue) repeats = max(1, stoi(argv[++i]));
+        else if (arg == "--min-batch-ms" && hasValue) minBatchMs = stod(argv[++i]);
+        else if (arg == "--out" && hasValue) outPath = argv[++i];
+        else if (arg == "--baseline" && hasValue) baselinePath = argv[++i];
+        else if (arg == "--tolerance" && hasValue) tolerance = stod(argv[++i]);
+        else {
+            cerr << "unknown argument: " << arg << "\n";
+            return 2;
+        }
+    }
+
+    vector<CaseResult> results;
+    try {
+        NullRenderTarget target(Vector2u(1408, 728));
+        Input::getInstance().setWindow(nullptr);
+        Input::getInstance().startScript(1.0f / 30.0f);  // no keys held, every tick lasts 1/30 s
+        Input::getInstance().beginFrame();
+        GameClock::getInstance().tick(Input::getInstance().getDeltaTime());  // every frame delta the animations read is 1/30 s
+
+        // TextManager::handleTextWrapping on the longest narrative lines: measured from scratch (the cache is
+        // emptied first, as after setText) and as the cache hit of a size that was already shown
+        struct WrapCase { const char* name; const char* cachedName; string text; };
+        WrapCase wrapCases[] = {
+            { "wrap_tinman_longest", "wrap_tinman_cached", longestLine({ TinmanNarrative::getStartNarrative(),
+                TinmanNarrative::getPreRiddleDialogue(), TinmanNarrative::getGoodEndNarrative(), TinmanNarrative::getBadEndNarrative() }) },
+            { "wrap_scarecrow_longest", "wrap_scarecrow_cached", longestLine({ ScarecrowNarrative::getStartNarrative(),
+                ScarecrowNarrative::getGoodEndNarrative(), ScarecrowNarrative::getBadEndNarrative() }) },
+        };
+        for (const WrapCase& wrapCase : wrapCases) {
+            if (!matchesFilter(wrapCase.name, filter) && !matchesFilter(wrapCase.cachedName, filter)) continue;
+            TextManager text(target, wrapCase.text);
+            if (matchesFilter(wrapCase.name, filter)) {
+                results.push_back(measure(wrapCase.name, repeats, minBatchMs, [&] {
+                    text.forgetWrappedSizes();
+                    text.handleTextWrapping();
+                }));
+            }
+            if (matchesFilter(wrapCase.cachedName, filter)) {
+                results.push_back(measure(wrapCase.cachedName, repeats, minBatchMs, [&] { text.handleTextWrapping(); }));
+            }
+        }
+
+        // Dialogue::checkBackgroundChange against each chapter's triggers, on its longest line with a full chunk on screen
+        // (the chunk was scanned while typing, so this is what every later frame of the line pays)
+        struct TriggerCase { const char* name; TriggerAutomaton (*triggers)(); string text; };
+        TriggerCase triggerCases[] = {
+            { "background_triggers_lion", LionNarrative::getTriggerAutomaton, longestLine({ LionNarrative::getStartNarrative(),
+                LionNarrative::getRetryNarrative(), LionNarrative::getGoodEndNarrative() }) },
+            { "background_triggers_scarecrow", ScarecrowNarrative::getTriggerAutomaton, wrapCases[1].text },
+            { "background_triggers_tinman", TinmanNarrative::getTriggerAutomaton, wrapCases[0].text },
+            { "background_triggers_outro", OutroNarrative::getTriggerAutomaton, longestLine({ OutroNarrative::getGoodEndNarrative(),
+                OutroNarrative::getBadEndNarrative() }) },
+        };
+        for (const TriggerCase& triggerCase : triggerCases) {
+            if (!matchesFilter(triggerCase.name, filter)) continue;
+            Dialogue dialogue(target, Dialogue::DialogueType::Narrator, triggerCase.text);
+            dialogue.setBackgroundTriggers(triggerCase.triggers());
+            for (int i = 0; i < 5000 && !dialogue.awaitingChunk() && !dialogue.isTextComplete(); ++i) {
+                dialogue.update();  // types one character per update
+            }
+            results.push_back(measure(triggerCase.name, repeats, minBatchMs, [&] { dialogue.checkBackgroundChange(); }));
+        }
+
+        // QuestionHandler::loadCurrentQuestion: question box and answer button layout
+        if (matchesFilter("question_layout", filter)) {
+            QuestionHandler questions(target);
+            questions.setQuestions(TinmanNarrative::getTinmanQuestions());
+            results.push_back(measure("question_layout", repeats, minBatchMs, [&] { questions.loadCurrentQuestion(); }));
+        }
+
+        // QuestionStore::drawUnseen: the Scarecrow's 10 questions (scripted input, so the session pool is used)
+        if (matchesFilter("question_draw", filter)) {
+            results.push_back(measure("question_draw", repeats, minBatchMs, [&] {
+                keep(ScarecrowNarrative::getScarecrowQuestions(10));
+            }));
+        }
+
+        // Button construction (one answer button)
+        if (matchesFilter("button_construct", filter)) {
+            const SdfFont& font = SdfFont::get(SdfFont::uiFontPath);
+            results.push_back(measure("button_construct", repeats, minBatchMs, [&] {
+                Button button(target, "Oil his joints and hope for the best", font, Vector2f(300.f, 300.f), Vector2f(800.f, 90.f));
+                keep(button);
+            }));
+        }
+
+        // GifAnimator::update on the menu animation
+        if (matchesFilter("gif_update", filter)) {
+            GifAnimator gif("resources/home/home_screen_", 66);
+            gif.loadFrames();
+            gif.setLooping(true);
+            results.push_back(measure("gif_update", repeats, minBatchMs, [&] { gif.update(); }));
+        }
+
+        // Lion::reset and Tinman::reset: what a retry or chapter load costs per scene (they used to be rebuilt)
+        if (matchesFilter("scene_reset_lion", filter)) {
+            Lion lion(target);
+            results.push_back(measure("scene_reset_lion", repeats, minBatchMs, [&] { lion.reset(); }));
+        }
+        if (matchesFilter("scene_reset_tinman", filter)) {
+            Tinman tinman(target);
+            results.push_back(measure("scene_reset_tinman", repeats, minBatchMs, [&] { tinman.reset(); }));
+        }
+    }
+    catch (const exception& e) {
+        cerr << e.what() << "\n";
+        return 2;
+    }
+
+    printTable(results);
+
+    ostringstream report;
+    writeReport(report, results, repeats, minBatchMs);
+    if (!outPath.empty()) {
+        ofstream out(outPath, ios::trunc);
+        out << report.str();
+        cerr << "wrote " << outPath << "\n";
+    }
+
+    if (!baselinePath.empty()) {
+        string baseline;
+        if (!readFile(baselinePath, baseline)) {
+            cerr << "could not read baseline " << baselinePath << "\n";
+            return 2;
+        }
+        int regressions = compareWithBaseline(flattenJsonNumbers(report.str()), flattenJsonNumbers(baseline),
+            tolerance, 0.0, cerr);
+        cerr << regressions << " regression(s) against " << baselinePath << "\n";
+        return regressions > 0 ? 1 : 0;
+    }
+    return 0;
+}
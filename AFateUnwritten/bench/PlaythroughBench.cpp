@@ -0,0 +1,268 @@
+// end-to-end benchmark: plays the whole game headlessly towards the good and the bad ending and
+// reports per scene startup time, frame time percentiles and resource I/O as JSON
+//
+// usage: AFateUnwrittenBench [--null-render] [--route good|bad|both] [--enter-interval N]
+//                            [--out results.json] [--baseline baseline.json]
+//                            [--tolerance 0.10] [--min-delta-ms 0.5]
+// exit code: 0 = ok, 1 = regressed against the baseline, 2 = a run did not finish or bad arguments
+// note: runs from the project directory (resources/ is relative) and overwrites savegame.dat like a new game does
+// note: memory peaks are reported once for the process, run one --route per process to get a route's own peaks
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "BenchReport.h"
+#include "PlaythroughDriver.h"
+#include "Game.h"
+#include "Input.h"
+#include "ResourceStats.h"
+#include "MemoryTracker.h"
+
+using namespace std;
+
+namespace {
+
+const float tickSeconds = 1.0f / 30.0f;      // scripted tick length, matches the game's ~30 ms frame pacing
+const long long maxTicks = 200000;           // safety net: a stuck run gives up instead of hanging the benchmark
+const int sceneCount = 6;
+
+const char* sceneNames[sceneCount] = { "menu", "intro", "lion", "scarecrow", "tinman", "outro" };
+
+// everything measured while one scene was current
+struct SceneResult {
+    bool visited = false;
+    double startupMs = 0.0;                  // the tick that switched to the scene (reset, music, transition waits)
+    SampleStats frames;                      // every later tick spent in the scene
+    ResourceStats::Snapshot io;              // I/O and uploads attributed to the scene
+};
+
+// one playthrough
+struct RunResult {
+    string name;
+    bool finished = false;
+    long long ticks = 0;
+    double constructMs = 0.0;                // Game constructor: window/target, every scene, the menu GIF
+    double totalMs = 0.0;
+    ResourceStats::Snapshot constructIo;
+    ResourceStats::Snapshot totalIo;
+    uint64_t trackedHeldBytes = 0;           // textures, font pages, images, sounds and music held at the end
+    SceneResult scenes[sceneCount];
+};
+
+double millisecondsSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+// counter difference between two snapshots, added onto target
+void addDelta(ResourceStats::Snapshot& target, const ResourceStats::Snapshot& before, const ResourceStats::Snapshot& after) {
+    target.fileReads += after.fileReads - before.fileReads;
+    target.fileWrites += after.fileWrites - before.fileWrites;
+    target.textureUploads += after.textureUploads - before.textureUploads;
+    target.textureBytes += after.textureBytes - before.textureBytes;
+}
+
+// plays one game from the menu until the retry prompt would come up
+RunResult playthrough(const string& name, PlaythroughDriver::Route route, Game::RenderMode mode, int enterInterval) {
+    RunResult result;
+    result.name = name;
+
+    Input::getInstance().startScript(tickSeconds);
+    ResourceStats& stats = ResourceStats::getInstance();
+    ResourceStats::Snapshot runStart = stats.snapshot();
+    auto runClock = chrono::steady_clock::now();
+
+    auto constructClock = chrono::steady_clock::now();
+    Game game(mode);
+    result.constructMs = millisecondsSince(constructClock);
+    ResourceStats::Snapshot previous = stats.snapshot();
+    addDelta(result.constructIo, runStart, previous);
+
+    PlaythroughDriver driver(route, enterInterval);
+    Game::Scene scene = game.getCurrentScene();
+    result.scenes[static_cast<int>(scene)].visited = true;
+
+    while (game.isRunning() && result.ticks < maxTicks) {
+        driver.prepareTick(game);
+
+        auto tickClock = chrono::steady_clock::now();
+        game.step();
+        double tickMs = millisecondsSince(tickClock);
+        result.ticks++;
+
+        Game::Scene now = game.getCurrentScene();
+        SceneResult& current = result.scenes[static_cast<int>(now)];
+        if (now != scene) {
+            current.visited = true;
+            current.startupMs += tickMs;
+            scene = now;
+        }
+        else {
+            current.frames.add(tickMs);
+        }
+
+        ResourceStats::Snapshot after = stats.snapshot();
+        addDelta(current.io, previous, after);
+        previous = after;
+    }
+
+    result.finished = !game.isRunning();
+    result.totalMs = millisecondsSince(runClock);
+    addDelta(result.totalIo, runStart, stats.snapshot());
+    result.trackedHeldBytes = MemoryTracker::getInstance().getTotal().bytes;
+    return result;
+}
+
+void writeIo(JsonWriter& json, const ResourceStats::Snapshot& io) {
+    json.value("file_reads", io.fileReads);
+    json.value("file_writes", io.fileWrites);
+    json.value("texture_uploads", io.textureUploads);
+    json.value("texture_bytes", io.textureBytes);
+}
+
+void writeReport(ostream& out, const vector<RunResult>& runs, Game::RenderMode mode, int enterInterval) {
+    JsonWriter json(out);
+    json.beginObject();
+    json.value("benchmark", string("playthrough"));
+    json.value("render_mode", string(mode == Game::RenderMode::Null ? "null" : "offscreen"));
+    json.value("tick_seconds", static_cast<double>(tickSeconds));
+    json.value("enter_interval", static_cast<uint64_t>(enterInterval));
+
+    json.beginObject("runs");
+    for (const RunResult& run : runs) {
+        json.beginObject(run.name);
+        json.value("status", string(run.finished ? "finished" : "timed_out"));
+        json.value("ticks", static_cast<uint64_t>(run.ticks));
+        json.value("construct_ms", run.constructMs);
+        json.value("total_ms", run.totalMs);
+        json.value("tracked_held_bytes", run.trackedHeldBytes);
+
+        json.beginObject("construct");
+        writeIo(json, run.constructIo);
+        json.endObject();
+
+        json.beginObject("totals");
+        writeIo(json, run.totalIo);
+        json.endObject();
+
+        json.beginObject("scenes");
+        for (int i = 0; i < sceneCount; ++i) {
+            const SceneResult& scene = run.scenes[i];
+            if (!scene.visited) continue;
+
+            json.beginObject(sceneNames[i]);
+            json.value("startup_ms", scene.startupMs);
+            json.value("frames", static_cast<uint64_t>(scene.frames.count()));
+            json.value("frame_mean_ms", scene.frames.mean());
+            json.value("frame_p50_ms", scene.frames.percentile(50));
+            json.value("frame_p90_ms", scene.frames.percentile(90));
+            json.value("frame_p99_ms", scene.frames.percentile(99));
+            json.value("frame_max_ms", scene.frames.max());
+            writeIo(json, scene.io);
+            json.endObject();
+        }
+        json.endObject();
+
+        json.endObject();
+    }
+    json.endObject();
+
+    // high-water marks only exist for the whole process: with --route both the second run's would include the first's
+    json.beginObject("process");
+    json.value("peak_rss_bytes", getPeakResidentBytes());
+    json.value("tracked_peak_bytes", MemoryTracker::getInstance().getTotal().peakBytes);
+    json.endObject();
+    json.endObject();
+}
+
+bool readFile(const string& path, string& contents) {
+    ifstream file(path, ios::binary);
+    if (!file) return false;
+    ostringstream buffer;
+    buffer << file.rdbuf();
+    contents = buffer.str();
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Game::RenderMode mode = Game::RenderMode::Offscreen;
+    string route = "both";
+    string outPath;
+    string baselinePath;
+    double tolerance = 0.10;
+    double minDeltaMs = 0.5;
+    int enterInterval = 8;
+
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--null-render") mode = Game::RenderMode::Null;
+        else if (arg == "--route" && hasValue) route = argv[++i];
+        else if (arg == "--out" && hasValue) outPath = argv[++i];
+        else if (arg == "--baseline" && hasValue) baselinePath = argv[++i];
+        else if (arg == "--tolerance" && hasValue) tolerance = stod(argv[++i]);
+        else if (arg == "--min-delta-ms" && hasValue) minDeltaMs = stod(argv[++i]);
+        else if (arg == "--enter-interval" && hasValue) enterInterval = stoi(argv[++i]);
+        else {
+            cerr << "unknown argument: " << arg << "\n";
+            return 2;
+        }
+    }
+    if (route != "good" && route != "bad" && route != "both") {
+        cerr << "--route must be good, bad or both\n";
+        return 2;
+    }
+
+    vector<RunResult> runs;
+    try {
+        if (route != "bad") {
+            runs.push_back(playthrough("good_ending", PlaythroughDriver::Route::GoodEnding, mode, enterInterval));
+        }
+        if (route != "good") {
+            runs.push_back(playthrough("bad_ending", PlaythroughDriver::Route::BadEnding, mode, enterInterval));
+        }
+    }
+    catch (const exception& e) {
+        cerr << e.what() << "\n";
+        return 2;
+    }
+
+    ostringstream report;
+    writeReport(report, runs, mode, enterInterval);
+    if (outPath.empty()) {
+        cout << report.str();
+    }
+    else {
+        ofstream out(outPath, ios::trunc);
+        out << report.str();
+        cerr << "wrote " << outPath << "\n";
+    }
+
+    int exitCode = 0;
+    for (const RunResult& run : runs) {
+        if (!run.finished) {
+            cerr << run.name << " did not reach the end within " << maxTicks << " ticks\n";
+            exitCode = 2;
+        }
+    }
+
+    if (!baselinePath.empty()) {
+        string baseline;
+        if (!readFile(baselinePath, baseline)) {
+            cerr << "could not read baseline " << baselinePath << "\n";
+            return 2;
+        }
+        int regressions = compareWithBaseline(flattenJsonNumbers(report.str()), flattenJsonNumbers(baseline),
+            tolerance, minDeltaMs, cerr);
+        cerr << regressions << " regression(s) against " << baselinePath << "\n";
+        if (regressions > 0 && exitCode == 0) {
+            exitCode = 1;
+        }
+    }
+    return exitCode;
+}
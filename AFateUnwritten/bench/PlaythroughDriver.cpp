@@ -0,0 +1,60 @@
+#include "PlaythroughDriver.h"
+#include "Input.h"
+
+using namespace std;
+using namespace sf;
+
+// constructor: remembers the route and how often to press Enter
+PlaythroughDriver::PlaythroughDriver(Route route, int enterInterval)
+    : route(route), enterInterval(enterInterval > 1 ? enterInterval : 2) {}
+
+// decides the input for the next tick, buttons are pressed on one tick and released on the next
+// because the scenes only react to a press edge
+void PlaythroughDriver::prepareTick(Game& game) {
+    Input& input = Input::getInstance();
+    bool press = (tick % 2) == 0;
+    tick++;
+
+    input.setKeyPressed(Keyboard::Enter, false);
+    input.setMouseButtonPressed(Mouse::Left, false);
+    input.setMousePosition(Vector2i(-1, -1));
+
+    if (game.getCurrentScene() == Game::Scene::Menu) {
+        input.setMousePosition(centerOf(game.getMenuItemBounds(0)));  // "Start"
+        input.setMouseButtonPressed(Mouse::Left, press);
+        return;
+    }
+
+    QuestionHandler* questions = game.getActiveQuestions();
+    if (questions) {
+        if (route == Route::BadEnding && game.isRiddleTimerRunning()) {
+            return;  // wait for the countdown to run out
+        }
+        bool answerCorrectly = route == Route::GoodEnding || game.getCurrentScene() == Game::Scene::Lion;
+        answer(*questions, answerCorrectly, press);
+        return;
+    }
+
+    input.setKeyPressed(Keyboard::Enter, (tick % enterInterval) == 0);
+}
+
+// first click picks an answer, the next one hits "Next"
+void PlaythroughDriver::answer(QuestionHandler& questions, bool answerCorrectly, bool press) {
+    Input& input = Input::getInstance();
+    int count = questions.getOptionCount();
+    int correct = questions.getCorrectOptionIndex();
+    if (count == 0 || correct < 0) return;
+
+    int choice = answerCorrectly ? correct : (correct + 1) % count;
+    FloatRect target = questions.getSelectedIndex() == choice
+        ? questions.getNextBounds()
+        : questions.getOptionBounds(choice);
+
+    input.setMousePosition(centerOf(target));
+    input.setMouseButtonPressed(Mouse::Left, press);
+}
+
+// middle of a rectangle in whole pixels
+Vector2i PlaythroughDriver::centerOf(const FloatRect& bounds) {
+    return Vector2i(static_cast<int>(bounds.left + bounds.width / 2.f), static_cast<int>(bounds.top + bounds.height / 2.f));
+}
@@ -0,0 +1,32 @@
+#ifndef PLAYTHROUGH_DRIVER_H
+#define PLAYTHROUGH_DRIVER_H
+
+// project includes
+#include "Game.h"
+
+// handles: playing the game by itself through scripted input (Input::startScript)
+// it looks at the game through Game's automation accessors and decides, once per tick, which keys
+// and mouse buttons to hold for the next tick: click "Start" in the menu, click answers and "Next"
+// in quizzes, and press Enter everywhere else
+class PlaythroughDriver {
+public:
+    // which ending the driver plays towards
+    enum class Route {
+        GoodEnding,     // every answer right, riddles answered in time
+        BadEnding       // Lion passed (failing it loops forever), every later answer wrong, riddle timer left to run out
+    };
+
+    PlaythroughDriver(Route route, int enterInterval);
+
+    void prepareTick(Game& game);   // sets the scripted input for the next Game::step()
+
+private:
+    Route route;                    // ending the driver aims for
+    int enterInterval;              // ticks between Enter presses (lets the typewriter text run for a while)
+    long long tick = 0;             // ticks prepared so far
+
+    void answer(QuestionHandler& questions, bool answerCorrectly, bool press); // click through one question
+    static sf::Vector2i centerOf(const sf::FloatRect& bounds);
+};
+
+#endif
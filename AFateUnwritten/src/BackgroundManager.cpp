@@ -1,21 +1,36 @@
 #include "BackgroundManager.h"
 #include "LoadResources.h"
+#include "FrameProfiler.h"
+#include "MemoryTracker.h"
 
 using namespace std;
 using namespace sf;
 
 // constructor : nothing to set up yet
 // standard practice does nothing now, makes possible future setup easier (and thought about object creation)
-BackgroundManager::BackgroundManager() {}
+BackgroundManager::BackgroundManager() : memoryOwner(MemoryTracker::getInstance().getCurrentOwner()) {}
+
+// destructor: the texture and decoded images go with the manager
+BackgroundManager::~BackgroundManager() {
+    MemoryTracker::getInstance().release(&defaultTexture);
+    MemoryTracker::getInstance().release(&bgTexture);
+    for (const auto& entry : prefetched) {
+        try {
+            JobSystem::getInstance().wait(entry.second->job);  // a running decode would track the image after this
+        }
+        catch (...) {}  // a failed decode is just not used, a destructor must not throw
+        MemoryTracker::getInstance().release(&entry.second->image);
+    }
+}
 
 // stores a reference to the render window so we can later scale backgrounds properly
-void BackgroundManager::setWindow(RenderWindow& win) {
+void BackgroundManager::setWindow(const RenderTarget& win) {
     window = &win;
 }
 
 // called when window gets resized  update the internal pointer and rescale background to fit new window size
-void BackgroundManager::resize(const RenderWindow& win) {
-    setWindow(const_cast<RenderWindow&>(win));            // cast away const so we can store a pointer
+void BackgroundManager::resize(const RenderTarget& win) {
+    setWindow(win);                                       // remember the target so later loads can rescale
     resizeSprite();                                       // recalculate scale for new size
 }
 
@@ -24,7 +39,8 @@ void BackgroundManager::resizeSprite() {
     if (!window) return; // make sure the window is set
 
     auto windowSize = window->getSize();                  // get current window size
-    auto textureSize = bgTexture.getSize();               // get size of the loaded texture
+    if (!bgSprite.getTexture()) return;                   // nothing shown yet
+    auto textureSize = bgSprite.getTexture()->getSize();  // get size of the texture on screen
 
     if (textureSize.x == 0 || textureSize.y == 0) return; // prevent divide-by-zero if nothing's loaded
 
@@ -36,15 +52,22 @@ void BackgroundManager::resizeSprite() {
 }
 
 // loads a background image from a file path and sets it as the initial background
+// scenes call this again on every reset, the same path is already in defaultTexture and costs nothing
 void BackgroundManager::setDefault(const string& path) {
-    resourceLoader(bgTexture, path);                      // attempts to load a texture from a file path and applies it to the target texture
-    bgSprite.setTexture(bgTexture);                       // attach the texture to the sprite
+    if (path != defaultPath) {
+        resourceLoader(defaultTexture, path);             // attempts to load a texture from a file path and applies it to the target texture
+        MemoryTracker::getInstance().track(&defaultTexture, MemoryTracker::Type::Texture, path,
+            static_cast<uint64_t>(defaultTexture.getSize().x) * defaultTexture.getSize().y * 4, memoryOwner); // may be a reset, not the constructor
+        defaultPath = path;
+    }
+    bgSprite.setTexture(defaultTexture, true);            // attach the texture to the sprite
+    currentKey.clear();                                   // no trigger picked this one
     resizeSprite();                                       // scale it to fit the window
 }
 
 // draws the current background sprite onto the provided render window
-void BackgroundManager::draw(RenderWindow& window) {
-    window.draw(bgSprite);
+void BackgroundManager::draw(RenderTarget& window) {
+    FrameProfiler::draw(window, bgSprite);
 }
 
 // allows external code to map a key to a background image file or retrieve the existing path for a key
@@ -59,13 +82,56 @@ void BackgroundManager::operator()(const string& key) {
         throw runtime_error("Background key not found: " + key); // if not found, throw error
     }
     const string& path = it->second; // get the file path associated with the key
-    resourceLoader(bgTexture, path); // attempts to load a texture from a file path and applies it to the target texture
-    bgSprite.setTexture(bgTexture);  // update the sprite with the new texture
+    loadTexture(path);               // uses the prefetched image if there is one, otherwise reads the file
+    bgSprite.setTexture(bgTexture, true); // update the sprite with the new texture
     currentKey = key;                // store which key is active
     resizeSprite();                  // make sure it fills the window
 }
 
+// a save may come from a build with other triggers, so unknown keys are ignored instead of thrown
+void BackgroundManager::restoreKey(const string& key) {
+    if (keyToPath.count(key)) {
+        (*this)(key);
+    }
+}
+
 // gives read-only access to all key/path pairs used for background switching
 const unordered_map<string, string>& BackgroundManager::getTriggerMap() const {
     return keyToPath;
-}
\ No newline at end of file
+}
+
+// queues a decode job for every mapped image so a trigger only has to upload the texture
+void BackgroundManager::prefetch() {
+    for (const auto& entry : keyToPath) {
+        const string& path = entry.second;
+        if (path.empty() || prefetched.count(path)) continue;
+
+        auto pending = make_shared<PrefetchedImage>();
+        string owner = memoryOwner;
+        pending->job = JobSystem::getInstance().schedule([pending, path, owner] {
+            pending->loaded = pending->image.loadFromFile(path);
+            ResourceStats::getInstance().recordFileRead();
+            if (pending->loaded) {
+                Vector2u size = pending->image.getSize();
+                MemoryTracker::getInstance().track(&pending->image, MemoryTracker::Type::Image, path,
+                    static_cast<uint64_t>(size.x) * size.y * 4, owner);
+            }
+        });
+        prefetched[path] = pending;
+    }
+}
+
+// uploads the prefetched image for path if it decoded successfully, falls back to a normal load otherwise
+void BackgroundManager::loadTexture(const string& path) {
+    auto it = prefetched.find(path);
+    if (it != prefetched.end()) {
+        JobSystem::getInstance().wait(it->second->job); // normally finished long before the trigger phrase
+        if (it->second->loaded && bgTexture.loadFromImage(it->second->image)) {
+            ResourceStats::getInstance().recordTextureUpload(bgTexture.getSize());
+            MemoryTracker::getInstance().track(&bgTexture, MemoryTracker::Type::Texture, path,
+                static_cast<uint64_t>(bgTexture.getSize().x) * bgTexture.getSize().y * 4, memoryOwner);
+            return;
+        }
+    }
+    resourceLoader(bgTexture, path);
+}
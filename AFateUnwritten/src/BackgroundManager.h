@@ -5,39 +5,59 @@
 #include <SFML/Graphics.hpp>
 #include <unordered_map>
 #include <string>
+#include <memory>
+
+// project includes
+#include "JobSystem.h"
 
 // handles loading, displaying, and switching background images
-// note: assumes valid window reference for lifetime of BackgroundManager usage
+// note: assumes valid render target reference for lifetime of BackgroundManager usage
 class BackgroundManager {
 public:
     // -- constructor --
     BackgroundManager();
+    ~BackgroundManager();                                   // releases the texture and prefetched images from the memory tracker
 
     // -- background management --
-    void setDefault(const std::string& path);               // loads and shows a default background
-    void draw(sf::RenderWindow& window);                    // draws the current background
+    void setDefault(const std::string& path);               // shows a default background (only loaded when the path changes)
+    void draw(sf::RenderTarget& window);                    // draws the current background
     void operator()(const std::string& key);                // switches background based on key
     std::string& operator[](const std::string& key);        // sets or gets the file path for a key
     const std::unordered_map<std::string, std::string>& getTriggerMap() const; // returns the key->path map
+    void prefetch();                                        // decodes every mapped image on the job system ahead of its trigger
+    const std::string& getCurrentKey() const { return currentKey; } // key of the triggered background (empty: the default)
+    void restoreKey(const std::string& key);                // switches to a saved key, an empty or unknown one keeps the current background
 
     // -- responsive UI support --
-    void resize(const sf::RenderWindow& window);            // resizes background to fit the window
+    void resize(const sf::RenderTarget& window);            // resizes background to fit the window
 
 private:
     // -- window context and association --
-    sf::RenderWindow* window = nullptr;                     // pointer to the main window
-    void setWindow(sf::RenderWindow& win);                  // sets the window for scaling
+    const sf::RenderTarget* window = nullptr;               // pointer to the main render target
+    void setWindow(const sf::RenderTarget& win);            // sets the render target for scaling
 
     // -- background assets --
-    sf::Texture bgTexture;                                  // the current background image
+    sf::Texture defaultTexture;                             // the default image, kept so scene resets don't reload it
+    std::string defaultPath;                                // file defaultTexture holds
+    sf::Texture bgTexture;                                  // the last triggered background image
     sf::Sprite bgSprite;                                    // sprite to display the texture
 
     // -- background key map --
     std::unordered_map<std::string, std::string> keyToPath; // map of string keys to file paths
     std::string currentKey = "";                            // keeps track of current background
 
+    // -- background prefetching --
+    struct PrefetchedImage {
+        JobSystem::JobHandle job;                           // decode job (image is only valid once it's done)
+        sf::Image image;                                    // decoded pixels, uploaded on the main thread when triggered
+        bool loaded = false;                                // false if the decode failed
+    };
+    std::unordered_map<std::string, std::shared_ptr<PrefetchedImage>> prefetched; // path -> decoded image
+    std::string memoryOwner;                                // memory tracker owner (whoever constructed the manager)
+
     // -- helper methods --
     void resizeSprite();                                    // rescales the sprite to fit window
+    void loadTexture(const std::string& path);              // uploads a prefetched image, or loads from disk
 };
 
 #endif 
@@ -1,5 +1,6 @@
 #include "Button.h"
 #include "ResizeManager.h"
+#include "FrameProfiler.h"
 
 using namespace std;
 using namespace sf;
@@ -9,7 +10,7 @@ const Color Button::DEFAULT = Color(0, 0, 0, 180);        // semi-transparent bl
 const Color Button::NEXT = Color(139, 0, 0, 180);         // semi-transparent red for "Next" buttons
 
 // constructor: sets up the button's shape, position, label, and appearance
-Button::Button(RenderWindow& window, const string& label, Font& font,
+Button::Button(RenderTarget& window, const string& label, const SdfFont& font,
     Vector2f position, Vector2f size, bool nextButton, LevelType level)
     : window(window), isNextButton(nextButton), levelType(level)
 {
@@ -18,7 +19,7 @@ Button::Button(RenderWindow& window, const string& label, Font& font,
     button.setFillColor(DEFAULT);
 
     text.setFont(font);
-    text.setString(label);
+    FrameProfiler::setString(text, label);
     text.setFillColor(Color::White);
 
     // scale text size based on window resolution
@@ -30,9 +31,9 @@ Button::Button(RenderWindow& window, const string& label, Font& font,
 }
 
 // draws the button and its text on the screen
-void Button::draw(RenderWindow& window) {
-    window.draw(button);
-    window.draw(text);
+void Button::draw(RenderTarget& window) {
+    FrameProfiler::draw(window, button);
+    FrameProfiler::draw(window, text);
 }
 
 // checks if a given point is inside the button's bounds (for mouse detection)
@@ -65,6 +66,20 @@ void Button::deselect() {
     button.setFillColor(DEFAULT);
 }
 
+// re-labels the button for another question: new text, place and level colour, nothing is reallocated
+void Button::setLabel(const string& label, Vector2f position, Vector2f size, LevelType level) {
+    levelType = level;
+    isSelected = false;
+    button.setSize(size);
+    button.setPosition(position);
+    button.setFillColor(DEFAULT);
+
+    FrameProfiler::setString(text, label);
+    Vector2f scale = ResizeManager::getScale(window);
+    text.setCharacterSize(static_cast<unsigned int>(ResizeManager::scaleText(36, scale.y)));
+    centerText(position, size);
+}
+
 // returns the level-specific highlight colour based on LevelType
 Color Button::getLevelColor() const {
     switch (levelType) {
@@ -5,6 +5,9 @@
 #include <SFML/Graphics.hpp>
 #include <string>
 
+// project includes
+#include "SdfText.h"
+
 // represents the level context for theming button highlights
 enum class LevelType {
     Lion,
@@ -16,30 +19,31 @@ enum class LevelType {
 class Button {
 public:
     // -- constructor --
-    Button(sf::RenderWindow& window, const std::string& label, sf::Font& font, sf::Vector2f position, sf::Vector2f size,
+    Button(sf::RenderTarget& window, const std::string& label, const SdfFont& font, sf::Vector2f position, sf::Vector2f size,
         bool nextButton = false, LevelType level = LevelType::Lion);
 
     // -- rendering --
-    void draw(sf::RenderWindow& window);            // renders the button and its label
+    void draw(sf::RenderTarget& window);            // renders the button and its label
 
     // -- interaction & state --
     bool contains(sf::Vector2f point) const;        // checks if the mouse is over the button
+    sf::FloatRect getBounds() const { return button.getGlobalBounds(); } // on-screen area of the button
     void setHover(bool isHovered);                  // updates appearance when hovered
     void select();                                  // applies selected highlight state
     void deselect();                                // removes selection and resets color
+    void setLabel(const std::string& label, sf::Vector2f position, sf::Vector2f size,
+        LevelType level);                           // re-labels a pooled button in place (selection is cleared)
 
     // -- responsive UI support --
     void resize(sf::Vector2f basePosition, sf::Vector2f baseSize);  // adjusts layout on window resize
 
 private:
     // -- window context  --
-    sf::RenderWindow& window;       // reference to the game window
+    sf::RenderTarget& window;       // reference to the game window
 
     // -- button handling --
-    sf::Font font;                  // font used for button label
-    std::string label;              // text label for the button
     sf::RectangleShape button;      // visual shape of the button
-    sf::Text text;                  // label displayed on the button
+    SdfText text;                   // label displayed on the button
     bool isSelected = false;        // whether the button is selected
     bool isNextButton;              // marks if this is a "Next" navigation button
     LevelType levelType;            // determines the highlight color by level context
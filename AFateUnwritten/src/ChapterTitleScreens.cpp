@@ -1,20 +1,21 @@
 #include <SFML/Graphics.hpp>
-#include <thread>
-#include <chrono>
+#include <cmath>
 
 #include "ChapterTitleScreens.h"
 #include "LoadResources.h"
+#include "Trace.h"
 #include "ResizeManager.h"
+#include "FrameProfiler.h"
 
 using namespace std;
 using namespace sf;
 
-ChapterTitleScreens::ChapterTitleScreens(RenderWindow& window)
-    : m_window(window), m_font(), m_text(), m_nextChapterText() {
-    resourceLoader(m_font, "resources/fonts/CALIFR.ttf");
+ChapterTitleScreens::ChapterTitleScreens(RenderTarget& target)
+    : m_target(target), m_font(SdfFont::get("resources/fonts/CALIFR.ttf")), m_nextChapterText() {
 }
 
-void ChapterTitleScreens::showNextChapter(const string& chapterName) {
+void ChapterTitleScreens::begin(const string& chapterName) {
+    Trace::Scope trace("ChapterTitleScreens::begin", "scene", chapterName);
 
     // load and play chapter screen music
     resourceLoader(m_chapterMusic, "resources/music/ChapterTitleMusic.ogg");
@@ -23,64 +24,28 @@ void ChapterTitleScreens::showNextChapter(const string& chapterName) {
 
     m_nextChapterText.setString(chapterName);
     m_nextChapterText.setFont(m_font);
-    m_nextChapterText.setFillColor(Color::White);
+    m_nextChapterText.setFillColor(Color::Transparent);
 
     // resize the text
-    Vector2f scale = ResizeManager::getScale(m_window);
+    Vector2f scale = ResizeManager::getScale(m_target);
     float scaledTextSize = ResizeManager::scaleText(100, scale.y);
     m_nextChapterText.setCharacterSize(static_cast<unsigned int>(scaledTextSize));
 
     FloatRect textBounds = m_nextChapterText.getLocalBounds();
     m_nextChapterText.setOrigin(textBounds.width / 2, textBounds.height / 2);
-    m_nextChapterText.setPosition(m_window.getSize().x / 2, m_window.getSize().y / 2);
-
-    m_window.clear();
-    m_window.draw(m_nextChapterText);
-    m_window.display();
-
-    Clock clock; //starts timer to measure how much time has passed
-    const float fadeDuration = 1.0f; // the fade in lasts for 1 second
-    const float holdDuration = 2.0f; // how long to stay fully visible
+    m_nextChapterText.setPosition(m_target.getSize().x / 2, m_target.getSize().y / 2);
+}
 
-    while (clock.getElapsedTime().asSeconds() < fadeDuration) {     // calculates transperency of text
-       
+void ChapterTitleScreens::draw(float elapsed) {
+    if (elapsed < fadeDuration) {
         // FADE IN //
-        float alpha = (clock.getElapsedTime().asSeconds() / fadeDuration) * 255;
-        
-        if (alpha > 255) //safety check
-        {
-            alpha = 255;
-        }
-        
+        float alpha = (elapsed / fadeDuration) * 255;
         m_nextChapterText.setFillColor(Color(255, 255, 255, static_cast<Uint8>(alpha)));
-
-        Event event;
-        while (m_window.pollEvent(event)) {
-            if (event.type == Event::Closed || event.type == Event::KeyPressed) {
-                return;
-            }
-        }
-
-        m_window.clear();
-        m_window.draw(m_nextChapterText);
-        m_window.display();
-
     }
-
-    // HOLD FULLY VISIBLE
-    clock.restart();    // restarts to start from 0 again after fade in
-    const float shiftDuration = 2.0f;   // how long it takes for one full color cycle
-    bool isReversing = false;   // reverses the animation back to white
-    float t;
-    while (clock.getElapsedTime().asSeconds() < holdDuration) {
-        float elapsed = clock.getElapsedTime().asSeconds();
-
-        // Oscillating time
-        t = fmod(elapsed / shiftDuration, 3.0f);  // This ensures it loops every 'shiftDuration' seconds
-        
-        if (isReversing) { // if isReversing true, the color shift is flipped, going back to original color
-            t = 1.0f - t;  // Reverse time (from orange to white)
-        }
+    else if (elapsed < fadeDuration + holdDuration) {
+        // HOLD FULLY VISIBLE
+        const float shiftDuration = 2.0f;   // how long it takes for one full color cycle
+        float t = fmod((elapsed - fadeDuration) / shiftDuration, 3.0f);  // This ensures it loops every 'shiftDuration' seconds
 
         //The use of sine function is to smoothly oscillate between color values
         int red = 255;
@@ -94,47 +59,24 @@ void ChapterTitleScreens::showNextChapter(const string& chapterName) {
         // at t = 1.0 , you're back to the start
         // this gives a symmetric back and forth pulse
 
-        m_nextChapterText.setFillColor(Color(red, green, blue));
-        
-        Event event;
-        while (m_window.pollEvent(event)) {
-            if (event.type == Event::Closed || event.type == Event::KeyPressed) {
-                return;
-            }
-        }
-
-        m_window.clear();
-        m_window.draw(m_nextChapterText);
-        m_window.display();
+        m_nextChapterText.setFillColor(Color(red, green, blue));  // recolours the glyph quads, no new layout
     }
-
-    // FADE OUT //
-    clock.restart();
-    while (clock.getElapsedTime().asSeconds() < fadeDuration) { // this loop will run until the team reaches fadeDuration
-
-        //calculate transparency(which is Alpha value)
-        float elapsed = clock.getElapsedTime().asSeconds();
-        float alpha = 255 - (elapsed / fadeDuration) * 255;
+    else {
+        // FADE OUT //
+        float alpha = 255 - ((elapsed - fadeDuration - holdDuration) / fadeDuration) * 255;
         if (alpha < 0) alpha = 0;   // safety to avoid negatives
 
         //As time increases alpha decreases from 255 to 0
         //At elapsed = 0, alpha will be 255, which is fully visible
         //At elapsed = fadeduration , alpha = 0 which is fully transparent
- 
-        m_nextChapterText.setFillColor(Color(255, 255, 255, static_cast<Uint8>(alpha)));
 
-        Event event;
-        while (m_window.pollEvent(event)) {
-            if (event.type == Event::Closed || event.type == Event::KeyPressed) {
-                return;
-            }
-        }
-
-        m_window.clear();
-        m_window.draw(m_nextChapterText);
-        m_window.display();
+        m_nextChapterText.setFillColor(Color(255, 255, 255, static_cast<Uint8>(alpha)));
     }
 
-    m_chapterMusic.stop(); // stop the chapter music
+    m_target.clear();
+    FrameProfiler::draw(m_target, m_nextChapterText);
 }
 
+void ChapterTitleScreens::end() {
+    m_chapterMusic.stop(); // stop the chapter music
+}
@@ -6,16 +6,27 @@
 #include <SFML/Audio.hpp>
 #include <string>
 
+// project includes
+#include "SdfText.h"
+
+// handles: the chapter title card (fade in, colour cycle, fade out) with its music
+// Game plays it as the TitleCard step of a SceneTransition: it is drawn once per frame of the main loop,
+// at the game time the step has run for, so nothing waits in a loop of its own
 class ChapterTitleScreens {
 public:
-    ChapterTitleScreens(sf::RenderWindow& window);
-    void showNextChapter(const std::string& chapterName);
+    ChapterTitleScreens(sf::RenderTarget& target);
+    void begin(const std::string& chapterName);  // lays the title out for the target and starts the title music
+    void draw(float elapsed);                    // draws the card elapsed game seconds in
+    void end();                                  // stops the title music
+
+    static constexpr float fadeDuration = 1.0f;  // the fade in and the fade out each last 1 second
+    static constexpr float holdDuration = 2.0f;  // how long to stay fully visible (colour cycling)
+    static constexpr float duration = fadeDuration + holdDuration + fadeDuration;
 
 private:
-    sf::RenderWindow& m_window;  // reference to the game window
-    sf::Font m_font;             // font for title text
-    sf::Text m_text;             // title text
-    sf::Text m_nextChapterText;  // text for next chapter prompt
+    sf::RenderTarget& m_target;  // where the card is drawn (the scenes' target)
+    const SdfFont& m_font;       // font for title text (its distance field atlas draws the 100pt title)
+    SdfText m_nextChapterText;   // text for next chapter prompt
     sf::Music m_chapterMusic;    // music for title screen only
 };
 
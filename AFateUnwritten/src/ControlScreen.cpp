@@ -1,5 +1,6 @@
 #include "ControlScreen.h"
 #include "LoadResources.h"
+#include "Trace.h"
 #include "ResizeManager.h"
 
 using namespace sf;
@@ -60,6 +61,7 @@ void ControlScreen::update() {
 
 // displays the control screen and handles user input
 ControlResult ControlScreen::show() {
+    Trace::Scope trace("ControlScreen::show", "modal");
     Event event;
 
     while (window.isOpen()) {
@@ -1,6 +1,8 @@
 #include "Dialogue.h"
 #include "ResizeManager.h"
-#include "LoadResources.h"
+#include "FrameProfiler.h"
+#include "EventBus.h"
+#include "GameEvents.h"
 
 #include <memory>
 
@@ -8,14 +10,25 @@ using namespace std;
 using namespace sf;
 
 // constructor: initialize dialogue with character's text
-Dialogue::Dialogue(RenderWindow &window, DialogueType characterType, const string &text)
+Dialogue::Dialogue(RenderTarget &window, DialogueType characterType, string_view text)
     : window(window), characterType(characterType) {
-    loadResources();                      // loads necessary resources like fonts
     loadCharacterInfo(characterType);     // loads character-specific dialogue info
-    textManager = make_unique<TextManager>(window, text, characterInfo.name);  // initialize the text manager with the current character's name
+    textManager = make_unique<TextManager>(window, text, characterInfo.name);  // initialize the text manager
     setComponentSize();  // set the size and position of UI components like name tag and text
 }
 
+// switches to the next line: speaker style, text and triggers start over, nothing is reloaded
+void Dialogue::setLine(const DialogueLine& line) {
+    characterType = line.speaker;
+    loadCharacterInfo(line.speaker);
+    textManager->setText(line.text);
+    setComponentSize();
+    lastAppliedText.clear();
+    displayedText.clear();
+    restartTriggers();             // a new line may fire the same phrases again
+    finishPublished = false;
+}
+
 // sets the size and position of name tag and dialogue components
 void Dialogue::setComponentSize() {
     auto scale = ResizeManager::getScale(window);  // get scale factors based on window size
@@ -25,15 +38,15 @@ void Dialogue::setComponentSize() {
 
     if (!characterName.empty() && characterName != "Narrator") {
         // set up nameTag (the bold label for the character's name)
-        nameTag.setFont(font);
-        nameTag.setString(characterName);
+        nameTag.setFont(SdfFont::get(SdfFont::uiFontPath));
+        FrameProfiler::setString(nameTag, characterName);
         nameTag.setFillColor(Color::White);
         nameTag.setCharacterSize(static_cast<unsigned>(55.f * scale.y));
         nameTag.setStyle(Text::Bold);
 
         // set up nameText (same as nameTag for optional subtitle)
-        nameText.setFont(font);
-        nameText.setString(characterName);
+        nameText.setFont(SdfFont::get(SdfFont::uiFontPath));
+        FrameProfiler::setString(nameText, characterName);
         nameText.setFillColor(Color::White);
         nameText.setCharacterSize(static_cast<unsigned>(55.f * scale.y));
 
@@ -60,11 +73,6 @@ void Dialogue::setComponentSize() {
 }
 
 
-// loads necessary resources like fonts for displaying text
-void Dialogue::loadResources() {
-    resourceLoader(font, "resources/fonts/INFROMAN.ttf");
-}
-
 // checks if the text is still being typed (waiting for the next chunk of text)
 bool Dialogue::awaitingChunk() const {
     return textManager->awaitingChunk();  // ask the text manager if it's waiting for more text
@@ -88,8 +96,8 @@ void Dialogue::loadCharacterInfo(DialogueType characterType) {
 void Dialogue::render() {
     // if it's not the narrator, draw the name background and the character's name text
     if (characterType != DialogueType::Narrator) {
-        window.draw(nameBackground);      // draw the name tag background
-        window.draw(nameText);            // draw the character's name
+        FrameProfiler::draw(window, nameBackground); // draw the name tag background
+        FrameProfiler::draw(window, nameText);       // draw the character's name
     }
     textManager->render();                // render the dialogue text below the name tag
 }
@@ -98,32 +106,75 @@ void Dialogue::render() {
 void Dialogue::update() {
     textManager->update();                // update the text manager (handles typing effect)
     checkBackgroundChange();              // check if a background change is triggered
+
+    if (!finishPublished && isTextComplete()) {
+        finishPublished = true;           // once per line, the scenes keep updating a finished line
+        EventBus::getInstance().publish(DialogueFinished{ this });
+    }
 }
 
-// checks if any background change phrases have been triggered
+// feeds the characters typed since the last check to the trigger automaton, only new text is ever looked at
+// fires at most one background change per call, like the player would see them appear
 void Dialogue::checkBackgroundChange() {
-    string fullDisplayed = textManager->getFullDisplayedText();  // get all the text that has been displayed so far
-    for (const auto &entry : backgroundChanges) {
-        const string &phrase = entry.first;  // phrase that triggers the background change
-        const string &image = entry.second;  // corresponding background image
-
-        if (fullDisplayed.find(phrase) != string::npos && triggeredPhrases.find(phrase) == triggeredPhrases.end()) {
-            triggeredPhrases.insert(phrase); // mark the phrase as triggered
-            if (onBackgroundChange) {
-                onBackgroundChange(phrase);  // call the callback function to change the background
+    FrameProfiler::Scope profile(FrameProfiler::Section::Triggers);
+    if (backgroundTriggers.empty()) return;
+
+    const string& shown = textManager->getDisplayedText();
+    if (textManager->getChunkIndex() != scannedChunk || shown.size() < scannedLength) {
+        triggerState = TriggerAutomaton::start;  // a new chunk (or re-wrapped text) is being typed from the top
+        scannedLength = 0;
+        scannedChunk = textManager->getChunkIndex();
+    }
+
+    while (true) {
+        for (uint32_t i = 0; i < backgroundTriggers.getMatchCount(triggerState); ++i) {
+            const uint32_t trigger = backgroundTriggers.getMatch(triggerState, i);
+            if (!triggered[trigger]) {
+                triggered[trigger] = true;   // mark the phrase as triggered
+                if (onBackgroundChange) {
+                    onBackgroundChange(string(backgroundTriggers.getPhrase(trigger)));  // change the background
+                }
+                return;
             }
-            break;
         }
+        if (scannedLength == shown.size()) return;
+        triggerState = backgroundTriggers.step(triggerState, shown[scannedLength++]);
     }
 }
 
+// the phrases already on screen count as fired: the scene restores the background they chose
+void Dialogue::setTypingState(const SceneSnapshot::Typing& state) {
+    textManager->setTypingState(state);
+    restartTriggers();
+    finishPublished = false;              // a line saved as finished is announced on the next update
+    if (backgroundTriggers.empty()) return;
+
+    const string& shown = textManager->getDisplayedText();
+    scannedChunk = textManager->getChunkIndex();
+    for (; scannedLength < shown.size(); ++scannedLength) {
+        triggerState = backgroundTriggers.step(triggerState, shown[scannedLength]);
+        for (uint32_t i = 0; i < backgroundTriggers.getMatchCount(triggerState); ++i) {
+            triggered[backgroundTriggers.getMatch(triggerState, i)] = true;
+        }
+    }
+}
+
+// forgets what was scanned and fired, for a new line or a restart
+void Dialogue::restartTriggers() {
+    triggerState = TriggerAutomaton::start;
+    scannedLength = 0;
+    scannedChunk = 0;
+    triggered.assign(backgroundTriggers.size(), false);
+}
+
 // resets the dialogue system (reuse in different scenes)
 void Dialogue::reset() {
     textManager->reset();          // reset the text manager to start fresh
     setComponentSize();            // recalculate size and position of name tag and text
     lastAppliedText = "";          // reset displayed text
     displayedText = "";            // reset text for the next sequence
-    triggeredPhrases.clear();      // clear all triggered background phrases
+    restartTriggers();             // clear all triggered background phrases
+    finishPublished = false;
 }
 
 // checks if the text is completely displayed
@@ -137,12 +188,13 @@ void Dialogue::setBackgroundChangeCallback(const function<void(const string&)> &
 }
 
 // sets the background change phrases (when certain phrases are displayed, change the background)
-void Dialogue::setBackgroundChanges(const unordered_map<string, string> &changes) {
-    backgroundChanges = changes;   // set the phrases and corresponding background images
+void Dialogue::setBackgroundTriggers(const TriggerAutomaton& triggers) {
+    backgroundTriggers = triggers; // a view into the compiled narrative, nothing is copied
+    restartTriggers();
 }
 
 // resizes components based on the window size
-void Dialogue::resize(RenderWindow &window) {
+void Dialogue::resize(RenderTarget &window) {
     textManager->resize();         // resize the text manager (handles all text resizing logic)
     setComponentSize();            // recalculate size and position of name tag and text
 }
\ No newline at end of file
@@ -4,13 +4,17 @@
 // SFML & Standard Library Includes
 #include <SFML/Graphics.hpp>
 #include <string>
+#include <string_view>
 #include <memory>
 #include <functional>
 #include <unordered_map>
-#include <unordered_set>
+#include <vector>
+#include <cstdint>
 
 // project includes
 #include "TextManager.h"
+#include "TriggerAutomaton.h"
+#include "SdfText.h"
 
 // handles: character dialogue, name tags, background change triggers
 class Dialogue {   
@@ -23,38 +27,45 @@ public:
     // struct for individual dialogue lines
     struct DialogueLine {
         DialogueType speaker;
-        std::string text;
+        std::string_view text;   // points into the compiled narrative (NarrativeStore)
     };
     // -- constructor --
-    Dialogue(sf::RenderWindow& window, DialogueType characterType, const std::string& text);
+    Dialogue(sf::RenderTarget& window, DialogueType characterType, std::string_view text);
+
+    // -- next line --
+    void setLine(const DialogueLine& line);  // shows a new line, reusing the font, shapes and text buffers
 
     // -- core functionality --
     void render();                 // render name tag and text
-    void update();                 // update typing effect and background trigger
+    void update();                 // update typing effect and background trigger (publishes DialogueFinished when the line is done)
     void reset();                  // reset dialogue state for reuse
     bool isTextComplete() const;   // check if all text has been displayed
     bool awaitingChunk() const;    // check if still typing current text
 
+    // -- save and resume --
+    SceneSnapshot::Typing getTypingState() const { return textManager->getTypingState(); }
+    void setTypingState(const SceneSnapshot::Typing& state); // resumes the current line there, without re-firing its triggers
+
     // -- background change management --
     void setBackgroundChangeCallback(const std::function<void(const std::string&)>& callback);
-    void setBackgroundChanges(const std::unordered_map<std::string, std::string>& changes);
+    void setBackgroundTriggers(const TriggerAutomaton& triggers); // the chapter's phrases (NarrativeStore::getTriggerAutomaton)
+    void checkBackgroundChange();  // fires the callback for the next untriggered phrase typed into the box (part of update)
 
     // -- responsive UI support --
-    void resize(sf::RenderWindow& newWindow);
+    void resize(sf::RenderTarget& newWindow);
 
 private:
     // -- rendering & display --
-    sf::RenderWindow& window;                // main game window
-    sf::Font font;                           // dialogue font
-    sf::Text nameTag;                        // speaker name (styled bold)
-    sf::Text nameText;                       // speaker name text
+    sf::RenderTarget& window;                // main game window
+    SdfText nameTag;                         // speaker name (styled bold)
+    SdfText nameText;                        // speaker name text (drawn from the dialogue font's atlas at any scale)
     sf::RectangleShape nameBackground;       // background for name tag
     sf::Text dialogueText;                   // main dialogue text
 
     // -- dialogue initialization --
-    void loadResources();                                // load font and assets
     void loadCharacterInfo(DialogueType characterType);  // load speaker styles
     void setComponentSize();                             // size and position setup
+    void restartTriggers();                              // nothing scanned or fired yet
 
     // -- name & layout --
     std::string characterName;
@@ -79,10 +90,13 @@ private:
     std::unique_ptr<TextManager> textManager;
 
     // -- background change system --
-    std::unordered_map<std::string, std::string> backgroundChanges;  // phrase -> image path map
-    std::unordered_set<std::string> triggeredPhrases;                // phrases already triggered
+    TriggerAutomaton backgroundTriggers;                             // matches the phrases as characters appear
+    std::uint32_t triggerState = TriggerAutomaton::start;            // after the characters scanned so far
+    std::size_t scannedLength = 0;                                   // characters of the box already fed in
+    int scannedChunk = 0;                                            // chunk those characters belong to
+    std::vector<bool> triggered;                                     // per trigger, fired during this line
+    bool finishPublished = false;                                    // DialogueFinished went out for this line
     std::function<void(const std::string&)> onBackgroundChange;      // callback for background swaps
-    void checkBackgroundChange();
 
     // -- accessor --
     TextManager& getTextManager() const { return *textManager; }
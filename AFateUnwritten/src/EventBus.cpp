@@ -0,0 +1,7 @@
+#include "EventBus.h"
+
+// singleton: get the single instance of EventBus
+EventBus& EventBus::getInstance() {
+    static EventBus instance;
+    return instance;
+}
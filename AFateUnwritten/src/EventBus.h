@@ -0,0 +1,98 @@
+#ifndef EVENT_BUS_H
+#define EVENT_BUS_H
+
+// Standard Library Includes
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <typeindex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// handles: typed publish/subscribe between the parts of the game (the events are in GameEvents.h)
+// the publisher reports what happened once, when it happens, and whoever cares reacts, so nobody has to poll every frame
+// handlers run right away on the publishing thread, in the order they subscribed
+// note: main thread only, jobs on the JobSystem must not publish
+class EventBus {
+public:
+    static EventBus& getInstance();                 // singleton pattern: one bus for the whole game
+
+    using SubscriptionId = std::uint32_t;           // what unsubscribe needs back (0 is never handed out)
+
+    // calls handler for every Event published from now on
+    template <typename Event>
+    SubscriptionId subscribe(std::function<void(const Event&)> handler) {
+        const SubscriptionId id = ++lastId;
+        getChannel<Event>().subscribers.push_back({ id, std::move(handler) });
+        return id;
+    }
+
+    // stops a handler, also allowed from inside a handler of the same event
+    template <typename Event>
+    void unsubscribe(SubscriptionId id) {
+        Channel<Event>& channel = getChannel<Event>();
+        for (auto& subscriber : channel.subscribers) {
+            if (subscriber.id == id) subscriber.handler = nullptr;
+        }
+        if (channel.publishing == 0) channel.removeStopped();  // otherwise publish drops it when done
+    }
+
+    // hands the event to every handler subscribed to its type
+    template <typename Event>
+    void publish(const Event& event) {
+        auto it = channels.find(std::type_index(typeid(Event)));
+        if (it == channels.end()) return;  // nobody ever listened
+
+        Channel<Event>& channel = static_cast<Channel<Event>&>(*it->second);
+        ++channel.publishing;
+        // by index and on a copy: a handler may subscribe more handlers, which can move the vector
+        // (those start with the next event)
+        const std::size_t count = channel.subscribers.size();
+        for (std::size_t i = 0; i < count; ++i) {
+            if (!channel.subscribers[i].handler) continue;
+            auto handler = channel.subscribers[i].handler;
+            handler(event);
+        }
+        if (--channel.publishing == 0) channel.removeStopped();
+    }
+
+    EventBus(const EventBus&) = delete;
+    EventBus& operator=(const EventBus&) = delete;
+
+private:
+    // constructor: ensure singleton pattern
+    EventBus() = default;
+
+    // the handlers of one event type
+    struct ChannelBase {
+        virtual ~ChannelBase() = default;
+    };
+    template <typename Event>
+    struct Channel : ChannelBase {
+        struct Subscriber {
+            SubscriptionId id;
+            std::function<void(const Event&)> handler;  // empty once unsubscribed
+        };
+        std::vector<Subscriber> subscribers;
+        int publishing = 0;                              // publish calls running on this channel (nested ones count too)
+
+        void removeStopped() {
+            subscribers.erase(std::remove_if(subscribers.begin(), subscribers.end(),
+                [](const Subscriber& subscriber) { return !subscriber.handler; }), subscribers.end());
+        }
+    };
+
+    template <typename Event>
+    Channel<Event>& getChannel() {
+        std::unique_ptr<ChannelBase>& channel = channels[std::type_index(typeid(Event))];
+        if (!channel) channel = std::make_unique<Channel<Event>>();
+        return static_cast<Channel<Event>&>(*channel);
+    }
+
+    std::unordered_map<std::type_index, std::unique_ptr<ChannelBase>> channels; // one channel per event type
+    SubscriptionId lastId = 0;
+};
+
+#endif
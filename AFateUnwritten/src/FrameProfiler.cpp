@@ -0,0 +1,239 @@
+#include "FrameProfiler.h"
+#include "LoadResources.h"
+#include "ResourceStats.h"
+#include "MemoryTracker.h"
+#include "SdfText.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+using namespace std;
+using namespace sf;
+
+const size_t FrameProfiler::historySize;
+const size_t FrameProfiler::averageFrames;
+
+// section labels in the order of FrameProfiler::Section
+static const char* sectionNames[] = { "events", "update", "  wrap", "  triggers", "render", "display", "sleep" };
+
+// singleton: get the single instance of FrameProfiler
+FrameProfiler& FrameProfiler::getInstance() {
+    static FrameProfiler instance;
+    return instance;
+}
+
+// constructor: reserves the frame history
+FrameProfiler::FrameProfiler() : history(historySize) {
+    panel.setFillColor(Color(0, 0, 0, 170));
+    panel.setOutlineColor(Color(255, 255, 255, 90));
+    panel.setOutlineThickness(1.f);
+}
+
+// scoped timer: starts timing
+FrameProfiler::Scope::Scope(Section section)
+    : section(section), start(chrono::steady_clock::now()) {}
+
+// scoped timer: adds the elapsed time to its section
+FrameProfiler::Scope::~Scope() {
+    chrono::duration<double, milli> elapsed = chrono::steady_clock::now() - start;
+    FrameProfiler::getInstance().addTime(section, elapsed.count());
+}
+
+// finishes the running frame (frame time, resource loads) and starts the next one
+void FrameProfiler::beginFrame() {
+    auto now = chrono::steady_clock::now();
+    uint64_t fileReads = ResourceStats::getInstance().snapshot().fileReads;
+
+    if (frameStarted) {
+        current.frameMs = chrono::duration<double, milli>(now - frameStart).count();
+        current.counters[static_cast<int>(Counter::ResourceLoads)] = static_cast<int>(fileReads - fileReadsAtFrameStart);
+        history[nextSlot] = current;
+        nextSlot = (nextSlot + 1) % historySize;
+        recorded = min(recorded + 1, historySize);
+    }
+
+    current = FrameRecord();
+    frameStart = now;
+    fileReadsAtFrameStart = fileReads;
+    lastTexture = nullptr;
+    drawnFontPages.clear();  // a frame that was never presented: its fonts may be gone by now
+    frameStarted = true;
+}
+
+// the glyph pages the frame drew text from are measured once each, after drawing (when they have grown),
+// rather than under the tracker's lock on every text draw
+void FrameProfiler::measureFontPages() {
+    for (const auto& page : drawnFontPages) {
+        MemoryTracker::getInstance().trackFontPage(*page.first, page.second);
+    }
+    drawnFontPages.clear();
+}
+
+// adds time to a section of the running frame
+void FrameProfiler::addTime(Section section, double milliseconds) {
+    current.sectionMs[static_cast<int>(section)] += milliseconds;
+}
+
+// bumps a counter of the running frame
+void FrameProfiler::count(Counter counter, int amount) {
+    current.counters[static_cast<int>(counter)] += amount;
+}
+
+// a bind happens whenever a draw uses a different texture than the one before it
+void FrameProfiler::noteTexture(const Texture* texture) {
+    if (texture != lastTexture) {
+        count(Counter::TextureBinds);
+        lastTexture = texture;
+    }
+}
+
+// draws a sprite (binds its texture)
+void FrameProfiler::draw(RenderTarget& target, const Sprite& sprite) {
+    FrameProfiler& profiler = getInstance();
+    profiler.count(Counter::DrawCalls);
+    profiler.noteTexture(sprite.getTexture());
+    target.draw(sprite);
+}
+
+// draws text (binds the glyph page of its font and size)
+void FrameProfiler::draw(RenderTarget& target, const Text& text) {
+    FrameProfiler& profiler = getInstance();
+    profiler.count(Counter::DrawCalls);
+    if (text.getFont()) {
+        profiler.noteTexture(&text.getFont()->getTexture(text.getCharacterSize()));
+        auto page = make_pair(text.getFont(), text.getCharacterSize());
+        if (find(profiler.drawnFontPages.begin(), profiler.drawnFontPages.end(), page) == profiler.drawnFontPages.end()) {
+            profiler.drawnFontPages.push_back(page);  // a handful per frame, no lock here
+        }
+    }
+    target.draw(text);
+}
+
+// draws distance field text (binds the one atlas of its font, whatever the size)
+void FrameProfiler::draw(RenderTarget& target, const SdfText& text) {
+    FrameProfiler& profiler = getInstance();
+    profiler.count(Counter::DrawCalls);
+    if (text.getFont()) {
+        profiler.noteTexture(&text.getFont()->getTexture());
+    }
+    target.draw(text);
+}
+
+// draws a shape (binds its texture, or none)
+void FrameProfiler::draw(RenderTarget& target, const Shape& shape) {
+    FrameProfiler& profiler = getInstance();
+    profiler.count(Counter::DrawCalls);
+    profiler.noteTexture(shape.getTexture());
+    target.draw(shape);
+}
+
+// draws anything else, counted as untextured
+void FrameProfiler::draw(RenderTarget& target, const Drawable& drawable) {
+    FrameProfiler& profiler = getInstance();
+    profiler.count(Counter::DrawCalls);
+    profiler.noteTexture(nullptr);
+    target.draw(drawable);
+}
+
+// draws anything with explicit render states (binds their texture, or none)
+void FrameProfiler::draw(RenderTarget& target, const Drawable& drawable, const RenderStates& states) {
+    FrameProfiler& profiler = getInstance();
+    profiler.count(Counter::DrawCalls);
+    profiler.noteTexture(states.texture);
+    target.draw(drawable, states);
+}
+
+// changes the string of a text (every call re-lays out the glyphs)
+void FrameProfiler::setString(Text& text, const String& string) {
+    getInstance().count(Counter::SetString);
+    text.setString(string);
+}
+
+// changes the string of a distance field text (re-lays out the quads on the next draw)
+void FrameProfiler::setString(SdfText& text, const String& string) {
+    getInstance().count(Counter::SetString);
+    text.setString(string);
+}
+
+// finished frame by age, 0 being the latest
+const FrameProfiler::FrameRecord& FrameProfiler::getRecord(size_t age) const {
+    return history[(nextSlot + historySize - 1 - age) % historySize];
+}
+
+// draws frame time, fps, the section breakdown, counters and a frame time graph
+// the overlay itself is drawn straight to the target so it doesn't show up in its own counters
+void FrameProfiler::drawOverlay(RenderTarget& target) {
+    if (!overlayVisible || recorded == 0) return;
+
+    if (!fontLoaded) {
+        resourceLoader(font, "resources/fonts/INFROMAN.ttf");
+        text.setFont(font);
+        text.setCharacterSize(14);
+        text.setFillColor(Color::White);
+        fontLoaded = true;
+    }
+
+    // average the numbers over the last frames, counters come from the last finished frame
+    size_t frames = min(recorded, averageFrames);
+    FrameRecord average;
+    for (size_t i = 0; i < frames; ++i) {
+        const FrameRecord& record = getRecord(i);
+        average.frameMs += record.frameMs / frames;
+        for (int s = 0; s < static_cast<int>(Section::Count); ++s) {
+            average.sectionMs[s] += record.sectionMs[s] / frames;
+        }
+    }
+    const FrameRecord& last = getRecord(0);
+
+    ostringstream lines;
+    lines << fixed << setprecision(2);
+    lines << "frame " << average.frameMs << " ms  (" << setprecision(0)
+        << (average.frameMs > 0.0 ? 1000.0 / average.frameMs : 0.0) << " fps)\n" << setprecision(2);
+    for (int s = 0; s < static_cast<int>(Section::Count); ++s) {
+        lines << left << setw(12) << sectionNames[s] << right << average.sectionMs[s] << " ms\n";
+    }
+    lines << "draws " << last.counters[static_cast<int>(Counter::DrawCalls)]
+        << "  binds " << last.counters[static_cast<int>(Counter::TextureBinds)] << "\n";
+    lines << "setString " << last.counters[static_cast<int>(Counter::SetString)]
+        << "  loads " << last.counters[static_cast<int>(Counter::ResourceLoads)] << "\n";
+    MemoryTracker::Usage memory = MemoryTracker::getInstance().getTotal();
+    lines << setprecision(1) << "memory " << memory.bytes / 1048576.0 << " MB  (peak " << memory.peakBytes / 1048576.0 << " MB)";
+
+    const View previousView = target.getView();
+    target.setView(target.getDefaultView());  // overlay in pixels, whatever view the scene used
+
+    const Vector2f origin(8.f, 8.f);
+    const float graphWidth = 240.f;
+    const float graphHeight = 60.f;
+    const float graphMaxMs = 50.f;            // bars are clipped at 50 ms
+
+    text.setString(lines.str());
+    text.setPosition(origin.x + 6.f, origin.y + 4.f);
+    FloatRect textBounds = text.getGlobalBounds();
+
+    float panelWidth = max(graphWidth, textBounds.width) + 12.f;
+    float graphTop = textBounds.top + textBounds.height + 10.f;
+    panel.setPosition(origin);
+    panel.setSize(Vector2f(panelWidth, graphTop + graphHeight + 6.f - origin.y));
+
+    // one bar per frame, oldest on the left, red above the 30 fps budget
+    graph.clear();
+    float barWidth = graphWidth / historySize;
+    for (size_t i = 0; i < recorded; ++i) {
+        const FrameRecord& record = getRecord(recorded - 1 - i);
+        float height = static_cast<float>(min(record.frameMs, static_cast<double>(graphMaxMs)) / graphMaxMs) * graphHeight;
+        float barLeft = origin.x + 6.f + i * barWidth;
+        float bottom = graphTop + graphHeight;
+        Color color = record.frameMs > 33.4 ? Color(220, 60, 60) : Color(90, 200, 90);
+        graph.append(Vertex(Vector2f(barLeft, bottom - height), color));
+        graph.append(Vertex(Vector2f(barLeft + barWidth, bottom - height), color));
+        graph.append(Vertex(Vector2f(barLeft + barWidth, bottom), color));
+        graph.append(Vertex(Vector2f(barLeft, bottom), color));
+    }
+
+    target.draw(panel);
+    target.draw(text);
+    target.draw(graph);
+    target.setView(previousView);
+}
@@ -0,0 +1,119 @@
+#ifndef FRAME_PROFILER_H
+#define FRAME_PROFILER_H
+
+// Standard Library Includes
+#include <chrono>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// SFML Includes
+#include <SFML/Graphics.hpp>
+
+class SdfText;
+
+// handles: per-frame timings and counters, shown as an overlay toggled with F3
+// code marks the part of the frame it belongs to with a Scope (a scoped timer), draws and text
+// changes on the frame path go through draw()/setString() so they can be counted
+// note: sections can nest (text wrapping and trigger matching happen inside the scene update),
+// so the section times don't add up to the frame time
+class FrameProfiler {
+public:
+    // parts of a frame that get their own timer
+    enum class Section {
+        Events,         // Game::handleEvents
+        Update,         // scene update (includes TextWrap and Triggers)
+        TextWrap,       // TextManager::handleTextWrapping
+        Triggers,       // Dialogue::checkBackgroundChange
+        Render,         // scene render
+        Display,        // presenting the frame
+        Sleep,          // frame pacing (job system help + sleep)
+        Count
+    };
+
+    // things counted per frame
+    enum class Counter {
+        DrawCalls,      // draw() calls
+        SetString,      // sf::Text::setString calls
+        TextureBinds,   // draws that switch to a different texture
+        ResourceLoads,  // files read (from ResourceStats)
+        Count
+    };
+
+    static FrameProfiler& getInstance();              // singleton pattern: one profiler for the game loop
+
+    // scoped timer: adds the time between construction and destruction to a section
+    class Scope {
+    public:
+        explicit Scope(Section section);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        Section section;
+        std::chrono::steady_clock::time_point start;
+    };
+
+    // -- frame bookkeeping --
+    void beginFrame();                                // closes the previous frame and starts a new one
+    void addTime(Section section, double milliseconds);
+    void measureFontPages();                          // tells MemoryTracker the size of the glyph pages drawn (before present)
+    void count(Counter counter, int amount = 1);
+
+    // -- counted drawing and text changes (use these on the frame path) --
+    static void draw(sf::RenderTarget& target, const sf::Sprite& sprite);
+    static void draw(sf::RenderTarget& target, const sf::Text& text);
+    static void draw(sf::RenderTarget& target, const SdfText& text);
+    static void draw(sf::RenderTarget& target, const sf::Shape& shape);
+    static void draw(sf::RenderTarget& target, const sf::Drawable& drawable);  // anything without a texture
+    static void draw(sf::RenderTarget& target, const sf::Drawable& drawable, const sf::RenderStates& states); // texture and shader given
+    static void setString(sf::Text& text, const sf::String& string);
+    static void setString(SdfText& text, const sf::String& string);
+
+    // -- overlay --
+    void toggleOverlay() { overlayVisible = !overlayVisible; }
+    bool isOverlayVisible() const { return overlayVisible; }
+    void drawOverlay(sf::RenderTarget& target);       // draws the stats in the top left corner (if visible)
+
+    FrameProfiler(const FrameProfiler&) = delete;
+    FrameProfiler& operator=(const FrameProfiler&) = delete;
+
+private:
+    // constructor: ensure singleton pattern
+    FrameProfiler();
+
+    // one finished (or running) frame
+    struct FrameRecord {
+        double frameMs = 0.0;                                            // start of this frame to start of the next
+        double sectionMs[static_cast<int>(Section::Count)] = {};
+        int counters[static_cast<int>(Counter::Count)] = {};
+    };
+
+    static const size_t historySize = 120;            // frames kept for the graph (~4 seconds at 30 fps)
+    static const size_t averageFrames = 30;           // frames averaged for the numbers (keeps them readable)
+
+    std::vector<FrameRecord> history;                 // ring buffer of finished frames
+    size_t nextSlot = 0;                              // where the next finished frame goes
+    size_t recorded = 0;                              // finished frames in history (up to historySize)
+    FrameRecord current;                              // frame in progress
+    std::chrono::steady_clock::time_point frameStart; // when the current frame began
+    std::uint64_t fileReadsAtFrameStart = 0;          // ResourceStats reading when the frame began
+    const sf::Texture* lastTexture = nullptr;         // texture of the previous draw (for bind counting)
+    std::vector<std::pair<const sf::Font*, unsigned int>> drawnFontPages; // glyph pages drawn this frame (for measureFontPages)
+    bool frameStarted = false;
+
+    // -- overlay --
+    bool overlayVisible = false;
+    bool fontLoaded = false;
+    sf::Font font;                                    // loaded the first time the overlay is shown
+    sf::Text text;
+    sf::RectangleShape panel;
+    sf::VertexArray graph{ sf::Quads };
+
+    void noteTexture(const sf::Texture* texture);     // counts a bind if the texture differs from the last one
+    const FrameRecord& getRecord(size_t age) const;   // age 0 = most recent finished frame
+};
+
+#endif
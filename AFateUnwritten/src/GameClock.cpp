@@ -0,0 +1,114 @@
+#include "GameClock.h"
+
+#include <algorithm>
+
+using namespace std;
+
+// singleton: get the single instance of GameClock
+GameClock& GameClock::getInstance() {
+    static GameClock instance;
+    return instance;
+}
+
+GameClock::GameClock() : wheel(slotCount) {}
+
+// called by Game once per frame, right after Input has measured (or replayed) the frame
+void GameClock::tick(float realDelta) {
+    if (paused || skipTick) {
+        deltaTime = 0.0f;
+        skipTick = false;
+        return;
+    }
+    deltaTime = realDelta * timeScale;
+    time += deltaTime;
+    advanceWheel();
+}
+
+void GameClock::setTimeScale(float scale) {
+    timeScale = max(scale, 0.0f);  // game time doesn't run backwards
+}
+
+void GameClock::startTimer(const string& name, float duration, float elapsed) {
+    NamedTimer& timer = timers[name];
+    unschedule(timer);
+    timer.start = time - elapsed;
+    timer.deadline = timer.start + duration;
+    timer.running = true;
+    timer.expired = time >= timer.deadline;  // a resumed save may already be out of time
+    if (!timer.expired) schedule(timer);
+}
+
+void GameClock::stopTimer(const string& name) {
+    auto it = timers.find(name);
+    if (it == timers.end() || !it->second.running) return;
+    unschedule(it->second);
+    it->second.running = false;
+    it->second.stoppedAt = time;
+}
+
+void GameClock::removeTimer(const string& name) {
+    auto it = timers.find(name);
+    if (it == timers.end()) return;
+    unschedule(it->second);
+    timers.erase(it);
+}
+
+bool GameClock::isTimerRunning(const string& name) const {
+    auto it = timers.find(name);
+    return it != timers.end() && it->second.running;
+}
+
+bool GameClock::hasTimerExpired(const string& name) const {
+    auto it = timers.find(name);
+    return it != timers.end() && it->second.expired;
+}
+
+float GameClock::getTimerElapsed(const string& name) const {
+    auto it = timers.find(name);
+    if (it == timers.end()) return 0.0f;
+    const NamedTimer& timer = it->second;
+    return static_cast<float>((timer.running ? time : timer.stoppedAt) - timer.start);
+}
+
+void GameClock::schedule(NamedTimer& timer) {
+    wheel[toTick(timer.deadline) % slotCount].push_back(&timer);
+    timer.inWheel = true;
+}
+
+void GameClock::unschedule(NamedTimer& timer) {
+    if (!timer.inWheel) return;
+    auto& slot = wheel[toTick(timer.deadline) % slotCount];
+    slot.erase(find(slot.begin(), slot.end(), &timer));
+    timer.inWheel = false;
+}
+
+// visits the slots from the last tick up to now, the last tick's slot again: its later deadlines may be due now
+// a frame longer than a whole turn visits every slot once
+void GameClock::advanceWheel() {
+    const uint64_t now = toTick(time);
+    if (now - wheelTick >= slotCount) {
+        for (auto& slot : wheel) expireDue(slot);
+    }
+    else {
+        for (uint64_t tick = wheelTick; tick <= now; ++tick) {
+            expireDue(wheel[tick % slotCount]);
+        }
+    }
+    wheelTick = now;
+}
+
+// timers from later turns share the slot and stay
+void GameClock::expireDue(vector<NamedTimer*>& slot) {
+    for (size_t i = 0; i < slot.size();) {
+        NamedTimer& timer = *slot[i];
+        if (timer.deadline <= time) {
+            timer.expired = true;
+            timer.inWheel = false;
+            slot[i] = slot.back();
+            slot.pop_back();
+        }
+        else {
+            ++i;
+        }
+    }
+}
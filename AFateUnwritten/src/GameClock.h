@@ -0,0 +1,76 @@
+#ifndef GAME_CLOCK_H
+#define GAME_CLOCK_H
+
+// Standard Library Includes
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// handles: game time, the one clock every timed system reads (countdowns, animations)
+// Game ticks it once per frame with Input's delta time (measured live, replayed from a log), so timed logic
+// reads one per-frame timestamp instead of the OS clock and a replay sees the same time as the recording
+// game time can be paused and scaled, and a frame spent in a blocking screen (pause menu, chapter title) is
+// dropped, so a countdown doesn't run while the player can't play
+// named timers sit in a timer wheel: a tick only looks at the slots the clock passed, not at every timer
+class GameClock {
+public:
+    static GameClock& getInstance();                // singleton pattern: one game time for the whole game
+
+    // -- per frame --
+    void tick(float realDelta);                     // advances game time by realDelta (scaled), expires due timers
+    float getDeltaTime() const { return deltaTime; } // game seconds this frame took (0 while paused)
+    double getTime() const { return time; }         // game seconds since the start
+
+    // -- scaling --
+    void setPaused(bool paused) { this->paused = paused; }
+    bool isPaused() const { return paused; }
+    void setTimeScale(float scale);                 // game seconds per real second (2: fast-forward), negative counts as 0
+    float getTimeScale() const { return timeScale; }
+    void skipNextTick() { skipTick = true; }        // the next frame's time went to a blocking screen, not to the game
+
+    // -- named timers --
+    void startTimer(const std::string& name, float duration, float elapsed = 0.0f); // (re)starts it as if elapsed seconds had gone by
+    void stopTimer(const std::string& name);        // freezes it (elapsed time stays readable)
+    void removeTimer(const std::string& name);      // forgets it
+    bool isTimerRunning(const std::string& name) const;  // started and not stopped since (expired ones keep running)
+    bool hasTimerExpired(const std::string& name) const; // duration reached since the last start
+    float getTimerElapsed(const std::string& name) const; // game seconds since the last start (0 for unknown timers)
+
+    GameClock(const GameClock&) = delete;
+    GameClock& operator=(const GameClock&) = delete;
+
+private:
+    // constructor: ensure singleton pattern
+    GameClock();
+
+    double time = 0.0;
+    float deltaTime = 0.0f;
+    float timeScale = 1.0f;
+    bool paused = false;
+    bool skipTick = false;
+
+    struct NamedTimer {
+        double start = 0.0;                         // game time it was (re)started at
+        double deadline = 0.0;                      // game time it expires at
+        double stoppedAt = 0.0;                     // game time it was stopped at
+        bool running = false;
+        bool expired = false;
+        bool inWheel = false;                       // waiting in a wheel slot
+    };
+    std::unordered_map<std::string, NamedTimer> timers; // node based: the wheel keeps pointers into it
+
+    // -- timer wheel --
+    static constexpr double slotSeconds = 1.0 / 32; // time one slot covers
+    static constexpr std::size_t slotCount = 256;   // slots per turn (8 seconds), later deadlines wait for their turn
+    std::vector<std::vector<NamedTimer*>> wheel;    // waiting timers, by slot of their deadline
+    std::uint64_t wheelTick = 0;                    // slot tick the wheel was last advanced to
+
+    static std::uint64_t toTick(double seconds) { return static_cast<std::uint64_t>(seconds / slotSeconds); }
+    void schedule(NamedTimer& timer);               // puts the timer in the slot of its deadline
+    void unschedule(NamedTimer& timer);             // takes it out again
+    void advanceWheel();                            // expires the timers due by now
+    void expireDue(std::vector<NamedTimer*>& slot); // expires the due timers of one slot
+};
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef GAME_EVENTS_H
+#define GAME_EVENTS_H
+
+// project includes
+#include "GameScore.h"
+
+class Dialogue;
+
+// the events published on the EventBus, handlers get them by const reference
+
+// an answer was confirmed with "Next" (published by QuestionHandler, GameScore keeps the score)
+struct AnswerSubmitted {
+    GameScore::ScoreType quiz;      // score the quiz counts towards (TOTALSCORE: none)
+    int question;                   // index of the question answered
+    bool correct;
+    int score;                      // correct answers so far
+};
+
+// the last question of a quiz was answered (published by QuestionHandler)
+struct QuizCompleted {
+    GameScore::ScoreType quiz;
+    int score;                      // correct answers in the whole quiz
+};
+
+// a dialogue line has been typed out and confirmed (published by Dialogue, once per line)
+struct DialogueFinished {
+    const Dialogue* dialogue;
+};
+
+// the chapters, in the order they are played
+enum class Chapter { Intro, Lion, Scarecrow, Tinman };
+
+// a chapter's last line is done, Enter moves on to the next chapter (published by the scene, Game switches)
+struct ChapterCompleted {
+    Chapter chapter;
+};
+
+#endif
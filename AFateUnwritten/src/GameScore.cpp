@@ -1,4 +1,6 @@
 #include "GameScore.h"
+#include "EventBus.h"
+#include "GameEvents.h"
 
 // singleton: Get the single instance of GameScore
 GameScore& GameScore::getInstance() {
@@ -10,7 +12,16 @@ GameScore& GameScore::getInstance() {
 GameScore::GameScore()
     : lion(0), scarecrow(0), tinman(0),
     total_score(0), tinmanquiz(0), tinmanriddle(0),
-    ending_condition(false) {}
+    ending_condition(false) {
+    // the quizzes report their answers, the scores follow them without the scenes copying them over every frame
+    EventBus& events = EventBus::getInstance();  // created first so it outlives the scores
+    events.subscribe<AnswerSubmitted>([this](const AnswerSubmitted& event) {
+        setScore(event.quiz, event.score);
+    });
+    events.subscribe<QuizCompleted>([this](const QuizCompleted& event) {
+        setScore(event.quiz, event.score);
+    });
+}
 
 // retrieve a specific score based on ScoreType
 int GameScore::getScore(ScoreType type) const {
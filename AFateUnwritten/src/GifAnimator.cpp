@@ -1,5 +1,10 @@
 #include "GifAnimator.h"
 #include "LoadResources.h" 
+#include "JobSystem.h"
+#include "GameClock.h"
+#include "Trace.h"
+#include "StartupReport.h"
+#include "MemoryTracker.h"
 
 using namespace std;
 using namespace sf;
@@ -7,28 +12,45 @@ using namespace sf;
 // constructor: initialize prefix for frames, total number of frames, and frame rate
 GifAnimator::GifAnimator(const string& prefix, int total, float frameRate)
     : framePrefix(prefix), totalFrames(total), frameDuration(1.0f / frameRate),
-    currentFrame(0), framesLoaded(false), looping(false), finished(false), currentLoopCount(0) {}
+    currentFrame(0), framesLoaded(false), looping(false), finished(false), currentLoopCount(0),
+    memoryOwner(MemoryTracker::getInstance().getCurrentOwner()) {}
 
 // load all frame textures based on naming convention
+// the PNGs are decoded (and their colours indexed) in parallel on the job system, the sheet is then packed and
+// uploaded here on the main thread
 bool GifAnimator::loadFrames() {
+    Trace::Scope trace("GifAnimator::loadFrames", "load", framePrefix);
+    StartupReport::Phase phase(StartupReport::Kind::Gif, framePrefix + "*.png");
+    JobSystem& jobs = JobSystem::getInstance();
+    vector<SpriteSheet::Frame> decoded(totalFrames);
+    vector<JobSystem::JobHandle> decodeJobs;
+
     for (int i = 0; i < totalFrames; ++i) {
-        Texture texture;
         string filename = framePrefix + to_string(i) + ".png";
-        resourceLoader(texture, filename); 
-        frames.push_back(texture);
+        decodeJobs.push_back(jobs.schedule([&decoded, i, filename] {
+            resourceLoader(decoded[i].image, filename);
+            SpriteSheet::indexColours(decoded[i]);
+        }));
     }
+    jobs.waitAll(decodeJobs);  // a frame that failed to load is rethrown here, on the main thread
 
-    // if frames were loaded successfully, set up the initial sprite
-    if (!frames.empty()) {
-        sprite.setTexture(frames[0]);
-        FloatRect bounds = sprite.getLocalBounds();
-        sprite.setOrigin(bounds.width / 2, bounds.height / 2); // center origin
-        framesLoaded = true;
+    for (int i = 0; i < totalFrames; ++i) {
+        phase.addFile(framePrefix + to_string(i) + ".png", true);
     }
+    frames.build(decoded, framePrefix + "*.png", memoryOwner);
+    framesLoaded = frames.getFrameCount() > 0;
 
     return framesLoaded;
 }
 
+// rewinds the animation so it can play again without decoding the frames a second time
+void GifAnimator::restart() {
+    currentFrame = 0;
+    frameTime = 0.0f;
+    currentLoopCount = 0;
+    finished = false;
+}
+
 // enable or disable looping behavior
 void GifAnimator::setLooping(bool shouldLoop) {
     looping = shouldLoop;
@@ -36,43 +58,41 @@ void GifAnimator::setLooping(bool shouldLoop) {
 
 // update the animation frame based on elapsed time
 void GifAnimator::update() {
-    if (frames.empty() || finished) return;
+    if (frames.getFrameCount() == 0 || finished) return;
 
-    if (clock.getElapsedTime().asSeconds() >= frameDuration) {
+    frameTime += GameClock::getInstance().getDeltaTime();
+    if (frameTime >= frameDuration) {
         currentFrame++;
 
-        if (currentFrame >= frames.size()) {
+        if (currentFrame >= frames.getFrameCount()) {
             if (looping) {
                 currentFrame = 0;  // restart animation from the beginning
                 currentLoopCount++;
             }
             else {
-                currentFrame = frames.size() - 1;  // stay on the last frame
+                currentFrame = static_cast<int>(frames.getFrameCount()) - 1;  // stay on the last frame
                 finished = true;
             }
         }
 
-        clock.restart(); // reset timer for next frame
+        frameTime = 0.0f; // reset timer for next frame
     }
 }
 
 // draw the current frame, scaled to fit the window size
-void GifAnimator::draw(RenderWindow& window) {
-    if (frames.empty()) return;
-
-    Sprite sprite;
-    sprite.setTexture(frames[currentFrame]);
+void GifAnimator::draw(RenderTarget& window) {
+    if (frames.getFrameCount() == 0) return;
 
-    // get window size and texture size
+    // get window size and frame size
     Vector2u windowSize = window.getSize();
-    Vector2u textureSize = frames[currentFrame].getSize();
+    Vector2u textureSize = frames.getFrameSize();
 
     // calculate scale factors to fill the window
     float scaleX = static_cast<float>(windowSize.x) / textureSize.x;
     float scaleY = static_cast<float>(windowSize.y) / textureSize.y;
 
     sprite.setScale(scaleX, scaleY); // apply scaling
-    window.draw(sprite);
+    frames.draw(window, sprite, currentFrame);
 }
 
 // check if the animation has completed
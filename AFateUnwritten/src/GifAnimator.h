@@ -6,15 +6,21 @@
 #include <vector>
 #include <string>
 
+// project includes
+#include "SpriteSheet.h"
+
 // manages the animation of a GIF-like sequence of frames
+// the frames are packed into a SpriteSheet: one upload per page, each frame is a texture rect on the one sprite
 class GifAnimator {
 public:
     // constructor: Initializes the animator with the frame prefix, total number of frames, and frame rate (default 10.0f)
     GifAnimator(const std::string& framePrefix, int totalFrames, float frameRate = 10.0f);
     
     bool loadFrames();                   // loads the frames from the provided frame prefix (returns true if successful)
+    bool areFramesLoaded() const { return framesLoaded; } // true once loadFrames has succeeded
+    void restart();                      // back to the first frame, keeping the loaded frames
     void update();                       // updates the current frame of the animation based on elapsed time
-    void draw(sf::RenderWindow& window); // draws the current frame to the provided window
+    void draw(sf::RenderTarget& window); // draws the current frame to the provided window
 
     void setLooping(bool shouldLoop);    // sets whether the animation should loop (true to loop, false to play once)
     bool isAnimationComplete() const;    // returns whether the animation is complete (all frames played)
@@ -33,10 +39,11 @@ private:
     int totalFrames;                    // total number of frames in the animation
     int currentFrame;                   // current frame index
     float frameDuration;                // duration of each frame (in seconds)
-    std::vector<sf::Texture> frames;    // vector to store the loaded frames as textures
+    SpriteSheet frames;                 // the loaded frames, packed (releases them from the memory tracker when destroyed)
+    std::string memoryOwner;            // memory tracker owner the frames are counted for (whoever constructed the animator)
 
-    sf::Sprite sprite;                  // sprite used to display the current frame
-    sf::Clock clock;                    // clock to keep track of time for frame updates
+    sf::Sprite sprite;                  // sprite used to display the current frame (its texture rect moves from frame to frame)
+    float frameTime = 0.0f;             // game time the current frame has been shown (sum of GameClock's frame deltas)
 
     bool framesLoaded;                  // flag indicating if the frames have been successfully loaded
     bool finished = false;              // flag indicating whether the animation has finished
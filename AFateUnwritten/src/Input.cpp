@@ -0,0 +1,337 @@
+#include "Input.h"
+
+#include <cstring>
+#include <stdexcept>
+
+using namespace std;
+using namespace sf;
+
+// input log layout (all values little endian, as written by the game itself):
+//   header: "AFUI", uint32 version, uint32 seed
+//   tick:   float deltaTime, int16 mouseX, int16 mouseY, uint8 pressed mouse buttons (bitmask),
+//           uint8 key count + one int8 key code per pressed key,
+//           uint16 event count + per event: uint8 type and a type specific payload
+static const char logMagic[4] = { 'A', 'F', 'U', 'I' };
+static const uint32_t logVersion = 1;
+
+// writes a plain value to the log
+template <typename T>
+static void writeValue(ofstream& file, const T& value) {
+    file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+// reads a plain value from the log, false at the end of the file
+template <typename T>
+static bool readValue(ifstream& file, T& value) {
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+// singleton: get the single instance of Input
+Input& Input::getInstance() {
+    static Input instance;
+    return instance;
+}
+
+// constructor: live runs get a fresh seed every time, replays overwrite it from the log
+Input::Input() {
+    random_device rd;
+    seed = rd();
+    randomEngine.seed(seed);
+}
+
+// destructor: make sure the last tick of a recording ends up on disk
+Input::~Input() {
+    stopRecording();
+}
+
+// attaches the window input is read from, without one every query reports "nothing pressed"
+void Input::setWindow(Window* window) {
+    this->window = window;
+}
+
+// letterboxing draws the target into part of the window at another scale, the scenes want target coordinates
+void Input::setTargetArea(const IntRect& area, Vector2u targetSize) {
+    targetArea = area;
+    this->targetSize = targetSize;
+}
+
+// starts a new tick, called once per main loop iteration before events are handled
+void Input::beginFrame() {
+    if (recording && frameStarted) {
+        writeFrame();
+    }
+    frameStarted = true;
+
+    sampledKeys.reset();
+    pressedKeys.reset();
+    sampledButtons.reset();
+    pressedButtons.reset();
+    mouseSampled = false;
+    mousePosition = Vector2i(-1, -1);
+    frameEvents.clear();
+    replayEvents.clear();
+
+    if (replaying) {
+        if (window) {
+            Event ignored;
+            while (window->pollEvent(ignored)) {}   // keep the window responsive, the log decides what happens
+        }
+        if (replayFinished || !readFrame()) {
+            replayFinished = true;
+            deltaTime = 0.0f;
+        }
+        return;
+    }
+    if (scripted) {
+        pressedKeys = scriptKeys;
+        pressedButtons = scriptButtons;
+        mousePosition = scriptMousePosition;
+        replayEvents.assign(scriptEvents.begin(), scriptEvents.end());
+        scriptEvents.clear();
+        deltaTime = scriptTickSeconds;
+        return;
+    }
+    deltaTime = frameClock.restart().asSeconds();
+}
+
+// returns the next event of this tick, from the window or from the replay log
+bool Input::pollEvent(Event& event) {
+    if (!isLive()) {
+        if (replayEvents.empty()) return false;
+        event = replayEvents.front();
+        replayEvents.pop_front();
+        if (recording && isLogged(event)) {
+            frameEvents.push_back(event);
+        }
+        return true;
+    }
+
+    if (!window || !window->pollEvent(event)) {
+        return false;
+    }
+    if (recording && isLogged(event)) {
+        frameEvents.push_back(event);
+    }
+    return true;
+}
+
+// returns whether a key is currently held down
+bool Input::isKeyPressed(Keyboard::Key key) {
+    if (key < 0 || key >= Keyboard::KeyCount) return false;
+    if (isLive() && !sampledKeys[key]) {
+        sampledKeys[key] = true;
+        pressedKeys[key] = window && Keyboard::isKeyPressed(key);
+    }
+    return pressedKeys[key];
+}
+
+// returns whether a mouse button is currently held down
+bool Input::isMouseButtonPressed(Mouse::Button button) {
+    if (button < 0 || button >= Mouse::ButtonCount) return false;
+    if (isLive() && !sampledButtons[button]) {
+        sampledButtons[button] = true;
+        pressedButtons[button] = window && Mouse::isButtonPressed(button);
+    }
+    return pressedButtons[button];
+}
+
+// returns the mouse position relative to the window (off screen when headless)
+Vector2i Input::getMousePosition() {
+    if (isLive() && !mouseSampled) {
+        mouseSampled = true;
+        if (window) {
+            mousePosition = Mouse::getPosition(*window);
+            if (targetArea.width > 0 && targetArea.height > 0) {
+                // window pixels to target pixels, the bars outside the area map outside the target
+                mousePosition.x = static_cast<int>((mousePosition.x - targetArea.left) * static_cast<float>(targetSize.x) / targetArea.width);
+                mousePosition.y = static_cast<int>((mousePosition.y - targetArea.top) * static_cast<float>(targetSize.y) / targetArea.height);
+            }
+        }
+    }
+    return mousePosition;
+}
+
+// opens a new input log, the current seed goes into its header
+void Input::startRecording(const string& path) {
+    recordFile.open(path, ios::binary | ios::trunc);
+    if (!recordFile) {
+        throw runtime_error("Error opening input recording: " + path);
+    }
+    recordFile.write(logMagic, sizeof(logMagic));
+    writeValue(recordFile, logVersion);
+    writeValue(recordFile, seed);
+    recording = true;
+    frameStarted = false;
+}
+
+// opens an input log for playback and reseeds the random engine with the recorded seed
+void Input::startReplay(const string& path) {
+    replayFile.open(path, ios::binary);
+    if (!replayFile) {
+        throw runtime_error("Error opening input replay: " + path);
+    }
+
+    char magic[4];
+    uint32_t version = 0;
+    if (!replayFile.read(magic, sizeof(magic)) || memcmp(magic, logMagic, sizeof(magic)) != 0
+        || !readValue(replayFile, version) || version != logVersion
+        || !readValue(replayFile, seed)) {
+        throw runtime_error("Error: not a valid input replay: " + path);
+    }
+    randomEngine.seed(seed);
+    replaying = true;
+    replayFinished = false;
+}
+
+// switches to scripted input: nothing is read from the window, every tick advances by the same amount
+void Input::startScript(float tickSeconds) {
+    scripted = true;
+    scriptTickSeconds = tickSeconds;
+    scriptKeys.reset();
+    scriptButtons.reset();
+    scriptMousePosition = Vector2i(-1, -1);
+    scriptEvents.clear();
+}
+
+// holds or releases a key for the script
+void Input::setKeyPressed(Keyboard::Key key, bool pressed) {
+    if (key < 0 || key >= Keyboard::KeyCount) return;
+    scriptKeys[key] = pressed;
+}
+
+// holds or releases a mouse button for the script
+void Input::setMouseButtonPressed(Mouse::Button button, bool pressed) {
+    if (button < 0 || button >= Mouse::ButtonCount) return;
+    scriptButtons[button] = pressed;
+}
+
+// moves the script's mouse
+void Input::setMousePosition(Vector2i position) {
+    scriptMousePosition = position;
+}
+
+// queues an event for the script's next tick
+void Input::pushEvent(const Event& event) {
+    scriptEvents.push_back(event);
+}
+
+// writes the tick in progress and closes the log
+void Input::stopRecording() {
+    if (!recording) return;
+    if (frameStarted) {
+        writeFrame();
+    }
+    recordFile.close();
+    recording = false;
+    frameStarted = false;
+}
+
+// appends the current tick: only keys/buttons that were queried and held are stored,
+// a replay asks for exactly the same ones since it runs the same code with the same input
+void Input::writeFrame() {
+    writeValue(recordFile, deltaTime);
+    writeValue(recordFile, static_cast<int16_t>(mousePosition.x));
+    writeValue(recordFile, static_cast<int16_t>(mousePosition.y));
+    writeValue(recordFile, static_cast<uint8_t>(pressedButtons.to_ulong()));
+
+    uint8_t keyCount = static_cast<uint8_t>(pressedKeys.count());
+    writeValue(recordFile, keyCount);
+    for (int key = 0; key < Keyboard::KeyCount; ++key) {
+        if (pressedKeys[key]) {
+            writeValue(recordFile, static_cast<int8_t>(key));
+        }
+    }
+
+    writeValue(recordFile, static_cast<uint16_t>(frameEvents.size()));
+    for (const Event& event : frameEvents) {
+        writeValue(recordFile, static_cast<uint8_t>(event.type));
+        switch (event.type) {
+            case Event::Resized:
+                writeValue(recordFile, static_cast<uint16_t>(event.size.width));
+                writeValue(recordFile, static_cast<uint16_t>(event.size.height));
+                break;
+            case Event::KeyPressed:
+            case Event::KeyReleased: {
+                uint8_t modifiers = (event.key.alt ? 1 : 0) | (event.key.control ? 2 : 0)
+                    | (event.key.shift ? 4 : 0) | (event.key.system ? 8 : 0);
+                writeValue(recordFile, static_cast<int8_t>(event.key.code));
+                writeValue(recordFile, modifiers);
+                break;
+            }
+            default:
+                break;  // closed / focus events carry no payload
+        }
+    }
+}
+
+// loads the next recorded tick into the snapshot
+bool Input::readFrame() {
+    int16_t mouseX = 0, mouseY = 0;
+    uint8_t buttons = 0, keyCount = 0;
+    if (!readValue(replayFile, deltaTime) || !readValue(replayFile, mouseX)
+        || !readValue(replayFile, mouseY) || !readValue(replayFile, buttons)
+        || !readValue(replayFile, keyCount)) {
+        return false;
+    }
+    mousePosition = Vector2i(mouseX, mouseY);
+    pressedButtons = bitset<Mouse::ButtonCount>(buttons);
+
+    for (uint8_t i = 0; i < keyCount; ++i) {
+        int8_t key = 0;
+        if (!readValue(replayFile, key)) return false;
+        if (key >= 0 && key < Keyboard::KeyCount) {
+            pressedKeys[key] = true;
+        }
+    }
+
+    uint16_t eventCount = 0;
+    if (!readValue(replayFile, eventCount)) return false;
+    for (uint16_t i = 0; i < eventCount; ++i) {
+        uint8_t type = 0;
+        if (!readValue(replayFile, type)) return false;
+
+        Event event;
+        memset(&event, 0, sizeof(event));
+        event.type = static_cast<Event::EventType>(type);
+        switch (event.type) {
+            case Event::Resized: {
+                uint16_t width = 0, height = 0;
+                if (!readValue(replayFile, width) || !readValue(replayFile, height)) return false;
+                event.size.width = width;
+                event.size.height = height;
+                break;
+            }
+            case Event::KeyPressed:
+            case Event::KeyReleased: {
+                int8_t code = 0;
+                uint8_t modifiers = 0;
+                if (!readValue(replayFile, code) || !readValue(replayFile, modifiers)) return false;
+                event.key.code = static_cast<Keyboard::Key>(code);
+                event.key.alt = (modifiers & 1) != 0;
+                event.key.control = (modifiers & 2) != 0;
+                event.key.shift = (modifiers & 4) != 0;
+                event.key.system = (modifiers & 8) != 0;
+                break;
+            }
+            default:
+                break;
+        }
+        replayEvents.push_back(event);
+    }
+    return true;
+}
+
+// the game only reacts to these, mouse movement and text input are left out to keep logs small
+bool Input::isLogged(const Event& event) {
+    switch (event.type) {
+        case Event::Closed:
+        case Event::Resized:
+        case Event::LostFocus:
+        case Event::GainedFocus:
+        case Event::KeyPressed:
+        case Event::KeyReleased:
+            return true;
+        default:
+            return false;
+    }
+}
@@ -0,0 +1,111 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+// Standard Library Includes
+#include <bitset>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+// SFML Includes
+#include <SFML/Window.hpp>
+#include <SFML/Graphics/Rect.hpp>
+
+// handles: keyboard and mouse queries for scenes and widgets
+// everything goes through here instead of sf::Keyboard / sf::Mouse so the game can run
+// without a window (headless runs have no window attached and report no input)
+// input is snapshotted once per tick: the first query of a key/button/mouse position in a frame
+// samples it, later queries in the same frame see the same value. together with the window events,
+// the tick's delta time and the RNG seed this is what gets written to (and read back from) an input log
+class Input {
+public:
+    static Input& getInstance();                                  // singleton pattern: one input source for the game
+
+    void setWindow(sf::Window* window);                           // window input is read from (nullptr = headless)
+    void setTargetArea(const sf::IntRect& area, sf::Vector2u targetSize); // the render target is shown scaled into area of the window (letterbox),
+                                                                  // mouse positions are mapped into the target (empty area: 1:1)
+
+    // -- per tick --
+    void beginFrame();                                            // starts a new tick: measures (or replays) delta time, clears the snapshot
+    bool pollEvent(sf::Event& event);                             // next window event of this tick (recorded/replayed like the rest)
+    float getDeltaTime() const { return deltaTime; }              // seconds since the previous tick
+
+    // -- queries --
+    bool isKeyPressed(sf::Keyboard::Key key);                     // true while the key is held down
+    bool isMouseButtonPressed(sf::Mouse::Button button);          // true while the mouse button is held down
+    sf::Vector2i getMousePosition();                              // mouse position relative to the game window
+
+    // -- randomness --
+    std::mt19937& getRandomEngine() { return randomEngine; }      // shared engine, seeded from the log when replaying
+
+    // -- recording and replay --
+    void startRecording(const std::string& path);                 // writes every tick to path (throws if it can't be opened)
+    void startReplay(const std::string& path);                    // feeds the ticks in path back instead of live input
+    void stopRecording();                                         // flushes the last tick and closes the log
+    bool isReplaying() const { return replaying; }
+    bool isReplayFinished() const { return replaying && replayFinished; } // true once every recorded tick was played back
+    bool isReproducible() const { return recording || replaying || scripted; } // the run must not depend on anything outside its log or script
+
+    // -- scripted input (benchmarks drive the game without a player) --
+    void startScript(float tickSeconds);                          // from now on input comes from the setters below, every tick lasts tickSeconds
+    void setKeyPressed(sf::Keyboard::Key key, bool pressed);      // held state of a key from the next tick on
+    void setMouseButtonPressed(sf::Mouse::Button button, bool pressed); // held state of a mouse button from the next tick on
+    void setMousePosition(sf::Vector2i position);                 // mouse position from the next tick on
+    void pushEvent(const sf::Event& event);                       // event handed out during the next tick
+
+    ~Input();                                                     // flushes an active recording
+
+    Input(const Input&) = delete;
+    Input& operator=(const Input&) = delete;
+
+private:
+    // constructor: ensure singleton pattern, seeds the random engine
+    Input();
+
+    sf::Window* window = nullptr;                                 // window attached to the game, if any
+
+    // -- current tick snapshot --
+    float deltaTime = 0.0f;                                       // seconds since the previous tick
+    sf::Clock frameClock;                                         // measures deltaTime for live input
+    std::bitset<sf::Keyboard::KeyCount> sampledKeys;              // keys already queried this tick
+    std::bitset<sf::Keyboard::KeyCount> pressedKeys;              // held state of those keys
+    std::bitset<sf::Mouse::ButtonCount> sampledButtons;           // mouse buttons already queried this tick
+    std::bitset<sf::Mouse::ButtonCount> pressedButtons;           // held state of those buttons
+    bool mouseSampled = false;                                    // mouse position already queried this tick
+    sf::Vector2i mousePosition{ -1, -1 };                         // mouse position this tick
+    sf::IntRect targetArea;                                       // where the render target is shown in the window (empty: all of it, unscaled)
+    sf::Vector2u targetSize;                                      // size of the render target shown there
+    std::vector<sf::Event> frameEvents;                           // events handed out this tick (for the log)
+    std::deque<sf::Event> replayEvents;                           // events still to hand out this tick when replaying
+
+    // -- randomness --
+    std::uint32_t seed;                                           // seed of randomEngine (stored in the log header)
+    std::mt19937 randomEngine;                                    // used for question selection
+
+    // -- log --
+    std::ofstream recordFile;                                     // open while recording
+    std::ifstream replayFile;                                     // open while replaying
+    bool recording = false;
+    bool replaying = false;
+    bool replayFinished = false;
+    bool frameStarted = false;                                    // a tick is in progress (and still has to be recorded)
+
+    // -- script --
+    bool scripted = false;                                        // input comes from the script setters
+    float scriptTickSeconds = 0.0f;                               // delta time of every scripted tick
+    std::bitset<sf::Keyboard::KeyCount> scriptKeys;               // keys the script holds down
+    std::bitset<sf::Mouse::ButtonCount> scriptButtons;            // mouse buttons the script holds down
+    sf::Vector2i scriptMousePosition{ -1, -1 };                   // where the script put the mouse
+    std::vector<sf::Event> scriptEvents;                          // events queued for the next tick
+
+    bool isLive() const { return !replaying && !scripted; }       // input is read from the window
+
+    void writeFrame();                                            // appends the finished tick to the recording
+    bool readFrame();                                             // loads the next tick from the replay (false at the end)
+    static bool isLogged(const sf::Event& event);                 // whether an event type is kept in the log
+};
+
+#endif
@@ -0,0 +1,225 @@
+#include "JobSystem.h"
+#include "Trace.h"
+
+#include <algorithm>
+
+using namespace std;
+
+// index of the deque owned by the current thread (-1 on the main thread and any other non-worker)
+static thread_local int workerIndex = -1;
+
+// singleton: get the single instance of JobSystem
+JobSystem& JobSystem::getInstance() {
+    static JobSystem instance;
+    return instance;
+}
+
+// constructor: one deque per worker, leave a core for the main (render) thread
+JobSystem::JobSystem() {
+    unsigned int hardware = thread::hardware_concurrency();
+    unsigned int count = hardware > 1 ? hardware - 1 : 1;
+
+    for (unsigned int i = 0; i < count; ++i) {
+        queues.push_back(make_unique<WorkerQueue>());
+    }
+    for (unsigned int i = 0; i < count; ++i) {
+        workers.emplace_back(&JobSystem::workerLoop, this, static_cast<int>(i));
+    }
+}
+
+// destructor: finish whatever is still queued (e.g. a save write) before joining the workers
+JobSystem::~JobSystem() {
+    runUntilIdle();
+    {
+        lock_guard<mutex> lock(sleepMutex);
+        running = false;
+    }
+    wakeCondition.notify_all();
+    for (auto& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+// creates a job that will not run until it is submitted
+JobSystem::JobHandle JobSystem::createJob(function<void()> work) {
+    auto job = make_shared<Job>();
+    job->work = move(work);
+    return job;
+}
+
+// makes job wait for dependsOn, must be called before job is submitted
+void JobSystem::addDependency(const JobHandle& job, const JobHandle& dependsOn) {
+    if (!job || !dependsOn) return;
+
+    lock_guard<mutex> lock(dependsOn->mutex);
+    if (dependsOn->done) return;    // already finished, nothing to wait for
+
+    job->pendingDependencies++;
+    dependsOn->continuations.push_back(job);
+}
+
+// releases the submit token, the job is queued as soon as all dependencies are done
+void JobSystem::submit(const JobHandle& job) {
+    if (job && --job->pendingDependencies == 0) {
+        enqueue(job);
+    }
+}
+
+// convenience: create, wire up dependencies and submit in one go
+JobSystem::JobHandle JobSystem::schedule(function<void()> work, const vector<JobHandle>& dependencies) {
+    JobHandle job = createJob(move(work));
+    for (const auto& dependency : dependencies) {
+        addDependency(job, dependency);
+    }
+    submit(job);
+    return job;
+}
+
+// returns whether the job has run
+bool JobSystem::isDone(const JobHandle& job) const {
+    return !job || job->done;
+}
+
+// blocks until the job is done, the calling thread helps with queued work instead of idling
+// a job that threw is rethrown here, to whoever waits for it (other jobs run while waiting are not)
+void JobSystem::wait(const JobHandle& job) {
+    while (!isDone(job)) {
+        if (!runOne()) {
+            unique_lock<mutex> lock(sleepMutex);
+            doneCondition.wait_for(lock, chrono::milliseconds(1), [&] { return isDone(job); });
+        }
+    }
+    if (job && job->failure) {
+        rethrow_exception(job->failure);
+    }
+}
+
+// waits for the whole batch before rethrowing: the other jobs may still be writing to what the caller owns
+void JobSystem::waitAll(const vector<JobHandle>& jobs) {
+    exception_ptr failure;
+    for (const auto& job : jobs) {
+        try {
+            wait(job);
+        }
+        catch (...) {
+            if (!failure) failure = current_exception();
+        }
+    }
+    if (failure) {
+        rethrow_exception(failure);
+    }
+}
+
+// runs one queued job on the calling thread
+bool JobSystem::runOne() {
+    JobHandle job = popOrSteal(workerIndex);
+    if (!job) return false;
+    execute(job);
+    return true;
+}
+
+// cooperative hook for the main loop: keep running jobs until nothing is queued or the budget runs out
+bool JobSystem::runUntilIdle(chrono::milliseconds budget) {
+    auto start = chrono::steady_clock::now();
+    while (queuedJobs > 0) {
+        if (budget != chrono::milliseconds::max() && chrono::steady_clock::now() - start >= budget) {
+            return false;
+        }
+        if (!runOne()) {
+            this_thread::yield(); // jobs are queued but currently being popped by a worker
+        }
+    }
+    return true;
+}
+
+// pushes a ready job: workers keep their own follow-up work local, everyone else round robins
+void JobSystem::enqueue(const JobHandle& job) {
+    int index = workerIndex >= 0
+        ? workerIndex
+        : static_cast<int>(nextQueue++ % queues.size());
+    {
+        lock_guard<mutex> lock(queues[index]->mutex);
+        queues[index]->jobs.push_back(job);
+    }
+    queuedJobs++;
+    {
+        lock_guard<mutex> lock(sleepMutex);  // pairs with the predicate check in workerLoop
+    }
+    wakeCondition.notify_one();
+}
+
+// pops from the back of the caller's own deque, otherwise steals from the front of another
+JobSystem::JobHandle JobSystem::popOrSteal(int ownIndex) {
+    if (ownIndex >= 0) {
+        WorkerQueue& own = *queues[ownIndex];
+        lock_guard<mutex> lock(own.mutex);
+        if (!own.jobs.empty()) {
+            JobHandle job = move(own.jobs.back());
+            own.jobs.pop_back();
+            queuedJobs--;
+            return job;
+        }
+    }
+
+    size_t count = queues.size();
+    size_t start = ownIndex >= 0 ? static_cast<size_t>(ownIndex) + 1 : 0;
+    for (size_t i = 0; i < count; ++i) {
+        WorkerQueue& victim = *queues[(start + i) % count];
+        lock_guard<mutex> lock(victim.mutex);
+        if (!victim.jobs.empty()) {
+            JobHandle job = move(victim.jobs.front());
+            victim.jobs.pop_front();
+            queuedJobs--;
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+// runs the work, marks the job done and queues any continuation whose last dependency this was
+// an exception is kept on the job for wait(): it must not end a worker thread or skip the bookkeeping below
+void JobSystem::execute(const JobHandle& job) {
+    if (job->work) {
+        Trace::Scope trace("job", "jobs");
+        try {
+            job->work();
+        }
+        catch (...) {
+            job->failure = current_exception();
+        }
+    }
+
+    vector<JobHandle> ready;
+    {
+        lock_guard<mutex> lock(job->mutex);
+        job->done = true;
+        ready.swap(job->continuations);
+    }
+    for (const auto& next : ready) {
+        if (--next->pendingDependencies == 0) {
+            enqueue(next);
+        }
+    }
+
+    {
+        lock_guard<mutex> lock(sleepMutex);
+    }
+    doneCondition.notify_all();
+}
+
+// worker body: run jobs while there are any, otherwise sleep until something is queued
+void JobSystem::workerLoop(int index) {
+    workerIndex = index;
+    Trace::getInstance().setThreadName("worker " + to_string(index));
+    while (true) {
+        if (runOne()) continue;
+
+        unique_lock<mutex> lock(sleepMutex);
+        wakeCondition.wait(lock, [this] { return !running || queuedJobs > 0; });
+        if (!running && queuedJobs == 0) {
+            return;
+        }
+    }
+}
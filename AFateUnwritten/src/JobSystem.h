@@ -0,0 +1,84 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+// Standard Library Includes
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// handles: background work (asset decoding, save writes) on a small work-stealing thread pool
+// every worker owns a deque: it pushes and pops its own jobs at the back and steals from the
+// front of the other deques when it runs dry. jobs can depend on other jobs, forming a task graph
+// note: jobs must not touch OpenGL (textures, fonts, windows), that stays on the main thread
+class JobSystem {
+public:
+    struct Job;                                   // a single unit of work plus its dependency state
+    using JobHandle = std::shared_ptr<Job>;       // shared so the caller and the pool can both hold it
+
+    static JobSystem& getInstance();              // singleton pattern: one pool for the whole game
+
+    // -- building the task graph --
+    JobHandle createJob(std::function<void()> work);                     // creates a job without queueing it
+    void addDependency(const JobHandle& job, const JobHandle& dependsOn); // job only starts once dependsOn has finished
+    void submit(const JobHandle& job);                                   // queues the job (runs when its dependencies are done)
+    JobHandle schedule(std::function<void()> work,
+        const std::vector<JobHandle>& dependencies = {});                // create + depend + submit in one call
+
+    // -- waiting and cooperative execution --
+    bool isDone(const JobHandle& job) const;      // true once the job has run (null handles count as done)
+    void wait(const JobHandle& job);              // blocks until the job is done, running other jobs meanwhile (rethrows what its work threw)
+    void waitAll(const std::vector<JobHandle>& jobs); // waits for every job, then rethrows the first failure (jobs may share the caller's locals)
+    bool runOne();                                // runs a single queued job on the calling thread (false if none)
+    bool runUntilIdle(std::chrono::milliseconds budget = std::chrono::milliseconds::max()); // main-thread hook: help until the queues are empty or the budget is spent
+
+    unsigned int getWorkerCount() const { return static_cast<unsigned int>(workers.size()); }
+
+    // -- lifetime --
+    ~JobSystem();                                 // drains outstanding work and joins the workers
+
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    struct Job {
+        std::function<void()> work;               // the actual task
+        std::atomic<int> pendingDependencies{ 1 };// unfinished dependencies (+1 until submitted)
+        std::vector<JobHandle> continuations;     // jobs waiting on this one
+        std::mutex mutex;                         // guards continuations and done
+        std::atomic<bool> done{ false };          // set once work has run (or thrown)
+        std::exception_ptr failure;               // what work threw, written before done is set
+    };
+
+private:
+    // constructor: ensure singleton pattern, spawns hardware_concurrency - 1 workers
+    JobSystem();
+
+    // per-worker job queue
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<JobHandle> jobs;
+    };
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues; // one deque per worker
+    std::vector<std::thread> workers;                 // worker threads
+    std::atomic<unsigned int> nextQueue{ 0 };         // round robin for jobs pushed from non-worker threads
+    std::atomic<int> queuedJobs{ 0 };                 // jobs sitting in any queue
+    std::atomic<bool> running{ true };                // false once shutting down
+
+    std::mutex sleepMutex;                            // workers sleep here when there is nothing to do
+    std::condition_variable wakeCondition;            // signalled whenever a job is queued
+    std::condition_variable doneCondition;            // signalled whenever a job finishes (for wait())
+
+    void enqueue(const JobHandle& job);               // pushes a ready job onto a deque
+    JobHandle popOrSteal(int ownIndex);               // own back first, then other fronts
+    void execute(const JobHandle& job);               // runs the job and releases its continuations (even if it throws)
+    void workerLoop(int index);                       // body of each worker thread
+};
+
+#endif
@@ -4,21 +4,71 @@
 #include <string>
 #include <stdexcept>
 #include <SFML/Audio.hpp> 
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include "ResourceStats.h"
+#include "Trace.h"
+#include "StartupReport.h"
+#include "MemoryTracker.h"
+
+// bookkeeping after a successful load: textures, fonts and sounds are also registered with the memory tracker
+// (images are only decoded here on their way to a texture, whoever keeps one tracks it)
+template <typename T>
+inline void recordResourceLoad(const T&, const std::string&) {
+    ResourceStats::getInstance().recordFileRead();
+}
+
+inline void recordResourceLoad(const sf::Texture& texture, const std::string& path) {
+    ResourceStats::getInstance().recordFileRead();
+    ResourceStats::getInstance().recordTextureUpload(texture.getSize());
+    MemoryTracker::getInstance().track(&texture, MemoryTracker::Type::Texture, path,
+        static_cast<std::uint64_t>(texture.getSize().x) * texture.getSize().y * 4);
+}
+
+inline void recordResourceLoad(const sf::Font& font, const std::string& path) {
+    ResourceStats::getInstance().recordFileRead();
+    MemoryTracker::getInstance().track(&font, MemoryTracker::Type::Font, path, 0);  // pages are tracked as they fill
+}
+
+inline void recordResourceLoad(const sf::SoundBuffer& buffer, const std::string& path) {
+    ResourceStats::getInstance().recordFileRead();
+    MemoryTracker::getInstance().track(&buffer, MemoryTracker::Type::SoundBuffer, path,
+        buffer.getSampleCount() * sizeof(sf::Int16));
+}
+
+// what kind of startup phase a load is, and whether loadFromFile reads the whole file up front
+template <typename T>
+inline StartupReport::Kind startupKind(const T&) { return StartupReport::Kind::Other; }
+inline StartupReport::Kind startupKind(const sf::Texture&) { return StartupReport::Kind::Texture; }
+inline StartupReport::Kind startupKind(const sf::Image&) { return StartupReport::Kind::Image; }
+inline StartupReport::Kind startupKind(const sf::SoundBuffer&) { return StartupReport::Kind::Sound; }
+inline StartupReport::Kind startupKind(const sf::Font&) { return StartupReport::Kind::Font; }
 
 // generic loader for most resources (Texture, Font, SoundBuffer, etc.)
 template <typename T>
 bool resourceLoader(T& resource, const std::string& path) {
+    Trace::Scope trace("resourceLoader", "load", path);
+    StartupReport::Phase phase(startupKind(resource), path);
+    phase.addFile(path, startupKind(resource) != StartupReport::Kind::Font);  // fonts are read glyph by glyph
     if (!resource.loadFromFile(path)) {
         throw std::runtime_error("Error loading resource from: " + path);
     }
+    recordResourceLoad(resource, path);
     return true;
 }
 
 // specialized loader for sf::Music (uses openFromFile instead of loadFromFile)
 inline bool resourceLoader(sf::Music& music, const std::string& path) {
+    Trace::Scope trace("resourceLoader", "load", path);
+    StartupReport::Phase phase(StartupReport::Kind::Music, path);
+    phase.addFile(path, false);  // music streams while it plays
     if (!music.openFromFile(path)) {
         throw std::runtime_error("Error opening music from: " + path);
     }
+    ResourceStats::getInstance().recordFileRead();
+    MemoryTracker::getInstance().track(&music, MemoryTracker::Type::Music, path,
+        static_cast<std::uint64_t>(music.getSampleRate()) * music.getChannelCount() * sizeof(sf::Int16));  // one second buffered
     return true;
 }
 
@@ -1,5 +1,6 @@
 #include "LoadScreen.h"
 #include "LoadResources.h"
+#include "Trace.h"
 #include "ResizeManager.h"
 #include <SFML/Window/Mouse.hpp>
 
@@ -87,6 +88,7 @@ void LoadScreen::updateOptions() {
 
 // main loop to display load screen and handle user interaction
 LoadChoice LoadScreen::show() {
+    Trace::Scope trace("LoadScreen::show", "modal");
     resize(); // make sure everything is scaled properly
     Event event;
 
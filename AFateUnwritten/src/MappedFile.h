@@ -0,0 +1,39 @@
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+// Standard Library Includes
+#include <cstddef>
+#include <string>
+
+// handles: a read-only memory mapping of a whole file, for compiled data the game reads in place
+// pages are loaded by the OS on first touch, so opening costs no read and nothing is copied
+class MappedFile {
+public:
+    MappedFile() {}
+    explicit MappedFile(const std::string& path);     // throws runtime_error when the file can't be mapped
+    ~MappedFile();
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* data() const { return bytes; }
+    std::size_t size() const { return length; }
+    bool isOpen() const { return bytes != nullptr; }
+
+private:
+    const char* bytes = nullptr;
+    std::size_t length = 0;
+#ifdef _WIN32
+    void* fileHandle = nullptr;                       // HANDLEs, kept as void* so windows.h stays out of the header
+    void* mappingHandle = nullptr;
+#else
+    int descriptor = -1;
+#endif
+
+    void close();
+    void swap(MappedFile& other) noexcept;
+};
+
+#endif
@@ -0,0 +1,228 @@
+#include "MemoryTracker.h"
+#include "JobSystem.h"
+#include "ResourceStats.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+using namespace std;
+using namespace sf;
+
+// type labels in the order of MemoryTracker::Type
+static const char* typeNames[] = { "texture", "font page", "font", "image", "sound", "music" };
+
+// singleton: get the single instance of MemoryTracker
+MemoryTracker& MemoryTracker::getInstance() {
+    static MemoryTracker instance;
+    return instance;
+}
+
+// scoped owner: becomes the current owner with a new generation
+MemoryTracker::OwnerScope::OwnerScope(const string& owner) : owner(owner) {
+    MemoryTracker& tracker = MemoryTracker::getInstance();
+    lock_guard<mutex> lock(tracker.trackerMutex);
+    previousOwner = tracker.currentOwner;
+    previousGeneration = tracker.currentGeneration;
+    generation = tracker.nextGeneration++;
+    tracker.currentOwner = owner;
+    tracker.currentGeneration = generation;
+    tracker.ownerGenerations[owner] = generation;
+}
+
+// scoped owner: restores the previous owner and drops what older instances of this owner held
+MemoryTracker::OwnerScope::~OwnerScope() {
+    MemoryTracker& tracker = MemoryTracker::getInstance();
+    lock_guard<mutex> lock(tracker.trackerMutex);
+    tracker.currentOwner = previousOwner;
+    tracker.currentGeneration = previousGeneration;
+    tracker.releaseOlder(owner, generation);
+}
+
+// tracks an allocation for the current owner, reloading outside any owner scope keeps the existing owner
+void MemoryTracker::track(const void* resource, Type type, const string& name, uint64_t bytes) {
+    lock_guard<mutex> lock(trackerMutex);
+    Key key(resource, 0);
+    auto existing = entries.find(key);
+    if (currentGeneration == 0 && existing != entries.end()) {
+        add(key, Entry{ type, existing->second.owner, existing->second.generation, name, bytes });
+    }
+    else {
+        add(key, Entry{ type, currentOwner, currentGeneration, name, bytes });
+    }
+}
+
+// tracks an allocation for a named owner (its latest instance)
+void MemoryTracker::track(const void* resource, Type type, const string& name, uint64_t bytes, const string& owner) {
+    lock_guard<mutex> lock(trackerMutex);
+    auto generation = ownerGenerations.find(owner);
+    add(Key(resource, 0), Entry{ type, owner, generation != ownerGenerations.end() ? generation->second : 0, name, bytes });
+}
+
+// glyph pages grow as new characters get drawn, so they are measured on use and belong to the font's owner
+void MemoryTracker::trackFontPage(const Font& font, unsigned int characterSize) {
+    Vector2u size = font.getTexture(characterSize).getSize();
+    uint64_t bytes = static_cast<uint64_t>(size.x) * size.y * 4;
+
+    lock_guard<mutex> lock(trackerMutex);
+    Key key(&font, characterSize);
+    auto page = entries.find(key);
+    if (page != entries.end() && page->second.bytes == bytes) return;  // nothing new since the last draw
+
+    auto face = entries.find(Key(&font, 0));
+    Entry entry{ Type::FontPage, currentOwner, currentGeneration, "font", bytes };
+    if (face != entries.end()) {
+        entry.owner = face->second.owner;
+        entry.generation = face->second.generation;
+        entry.name = face->second.name;
+    }
+    entry.name += " @" + to_string(characterSize) + "px";
+    add(key, entry);
+}
+
+// forgets an allocation along with any glyph pages (which share the font's address)
+void MemoryTracker::release(const void* resource) {
+    lock_guard<mutex> lock(trackerMutex);
+    auto it = entries.lower_bound(Key(resource, 0));
+    while (it != entries.end() && it->first.first == resource) {
+        auto next = std::next(it);
+        remove(it);
+        it = next;
+    }
+}
+
+// forgets everything held by any instance of owner
+void MemoryTracker::releaseOwner(const string& owner) {
+    lock_guard<mutex> lock(trackerMutex);
+    releaseOlder(owner, nextGeneration);
+}
+
+string MemoryTracker::getCurrentOwner() const {
+    lock_guard<mutex> lock(trackerMutex);
+    return currentOwner;
+}
+
+// inserts or replaces an entry and updates every total and high-water mark
+void MemoryTracker::add(const Key& key, Entry entry) {
+    auto existing = entries.find(key);
+    if (existing != entries.end()) {
+        remove(existing);
+    }
+
+    Usage* groups[] = { &total, &byType[static_cast<int>(entry.type)], &byOwner[entry.owner] };
+    for (Usage* usage : groups) {
+        usage->bytes += entry.bytes;
+        usage->count++;
+        usage->peakBytes = max(usage->peakBytes, usage->bytes);
+    }
+    entries.emplace(key, move(entry));
+}
+
+// removes an entry from the map and the totals (peaks stay)
+void MemoryTracker::remove(map<Key, Entry>::iterator it) {
+    const Entry& entry = it->second;
+    Usage* groups[] = { &total, &byType[static_cast<int>(entry.type)], &byOwner[entry.owner] };
+    for (Usage* usage : groups) {
+        usage->bytes -= entry.bytes;
+        usage->count--;
+    }
+    entries.erase(it);
+}
+
+// drops entries of owner made by instances before generation
+void MemoryTracker::releaseOlder(const string& owner, unsigned int generation) {
+    for (auto it = entries.begin(); it != entries.end();) {
+        auto next = std::next(it);
+        if (it->second.owner == owner && it->second.generation < generation) {
+            remove(it);
+        }
+        it = next;
+    }
+}
+
+MemoryTracker::Usage MemoryTracker::getTotal() const {
+    lock_guard<mutex> lock(trackerMutex);
+    return total;
+}
+
+MemoryTracker::Usage MemoryTracker::getByType(Type type) const {
+    lock_guard<mutex> lock(trackerMutex);
+    return byType[static_cast<int>(type)];
+}
+
+MemoryTracker::Usage MemoryTracker::getByOwner(const string& owner) const {
+    lock_guard<mutex> lock(trackerMutex);
+    auto it = byOwner.find(owner);
+    return it != byOwner.end() ? it->second : Usage();
+}
+
+vector<string> MemoryTracker::getOwners() const {
+    lock_guard<mutex> lock(trackerMutex);
+    vector<string> owners;
+    for (const auto& entry : byOwner) {
+        owners.push_back(entry.first);
+    }
+    return owners;
+}
+
+const char* MemoryTracker::getTypeName(Type type) {
+    return typeNames[static_cast<int>(type)];
+}
+
+// formats one group as "held (peak) in N allocations"
+static void writeUsage(ostream& out, const string& label, const MemoryTracker::Usage& usage) {
+    out << "  " << left << setw(22) << label << right
+        << setw(10) << usage.bytes / 1024.0 << " KB" << setw(12) << usage.peakBytes / 1024.0 << " KB"
+        << setw(8) << usage.count << "\n";
+}
+
+// human readable dump: totals, per type, per owner and the 20 largest allocations
+string MemoryTracker::dump() const {
+    lock_guard<mutex> lock(trackerMutex);
+    ostringstream out;
+    out << fixed << setprecision(1);
+
+    out << "memory held now and at its high-water mark\n";
+    out << "  " << left << setw(22) << "" << right << setw(13) << "held" << setw(15) << "peak" << setw(8) << "count" << "\n";
+    writeUsage(out, "total", total);
+
+    out << "by type\n";
+    for (int t = 0; t < static_cast<int>(Type::Count); ++t) {
+        writeUsage(out, typeNames[t], byType[t]);
+    }
+
+    out << "by owner\n";
+    for (const auto& owner : byOwner) {
+        writeUsage(out, owner.first, owner.second);
+    }
+
+    vector<const Entry*> largest;
+    for (const auto& entry : entries) {
+        largest.push_back(&entry.second);
+    }
+    size_t shown = min<size_t>(largest.size(), 20);
+    partial_sort(largest.begin(), largest.begin() + shown, largest.end(), [](const Entry* a, const Entry* b) {
+        return a->bytes > b->bytes;
+    });
+
+    out << "largest allocations\n";
+    for (size_t i = 0; i < shown; ++i) {
+        const Entry& entry = *largest[i];
+        out << "  " << setw(10) << entry.bytes / 1024.0 << " KB  " << left << setw(10) << typeNames[static_cast<int>(entry.type)]
+            << setw(16) << entry.owner << right << entry.name << "\n";
+    }
+    return out.str();
+}
+
+// writes the dump on the job system so the frame doesn't wait on disk
+void MemoryTracker::writeDump(const string& path) const {
+    string report = dump();
+    JobSystem::getInstance().schedule([report, path] {
+        ofstream file(path, ofstream::trunc);
+        ResourceStats::getInstance().recordFileWrite();
+        if (file.is_open()) {
+            file << report;
+        }
+    });
+}
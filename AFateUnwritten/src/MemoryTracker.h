@@ -0,0 +1,113 @@
+#ifndef MEMORY_TRACKER_H
+#define MEMORY_TRACKER_H
+
+// Standard Library Includes
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+// SFML Includes
+#include <SFML/Graphics/Font.hpp>
+
+// handles: how much video memory (textures, font pages) and RAM (decoded images, sounds, music buffers)
+// the game holds, per owner (the scene or screen that loaded it) and per asset type, with high-water marks
+// allocations are keyed by the address of the SFML object holding them, loading into the same object again
+// replaces its entry. constructing an owner again (scene reloads) releases what its previous instance held
+// note: sizes are what SFML allocates for the pixels/samples, driver overhead and mipmaps are not included
+class MemoryTracker {
+public:
+    // asset types
+    enum class Type {
+        Texture,        // sf::Texture, 4 bytes per pixel of video memory
+        FontPage,       // glyph texture of one font at one character size (grows as new glyphs are drawn)
+        Font,           // sf::Font itself (the face is streamed from disk, counted for the number of loads)
+        Image,          // decoded sf::Image kept in RAM (prefetched backgrounds)
+        SoundBuffer,    // sf::SoundBuffer, 16-bit samples in RAM
+        Music,          // sf::Music streaming buffer (one second of samples)
+        Count
+    };
+
+    // bytes and allocation count of a group, and the most bytes it ever held
+    struct Usage {
+        std::uint64_t bytes = 0;
+        std::uint64_t peakBytes = 0;
+        std::size_t count = 0;
+    };
+
+    static MemoryTracker& getInstance();              // singleton pattern: one tracker for the game
+
+    // scoped owner: everything tracked while it is alive belongs to owner, and when it ends whatever an
+    // earlier instance of the same owner still held is released (that instance is being replaced)
+    class OwnerScope {
+    public:
+        explicit OwnerScope(const std::string& owner);
+        ~OwnerScope();
+
+        OwnerScope(const OwnerScope&) = delete;
+        OwnerScope& operator=(const OwnerScope&) = delete;
+
+    private:
+        std::string owner;
+        std::string previousOwner;
+        unsigned int generation;
+        unsigned int previousGeneration;
+    };
+
+    // -- tracking --
+    void track(const void* resource, Type type, const std::string& name, std::uint64_t bytes);
+    void track(const void* resource, Type type, const std::string& name, std::uint64_t bytes,
+        const std::string& owner);                    // for loads outside the owner's constructor (jobs, late loads)
+    void trackFontPage(const sf::Font& font, unsigned int characterSize); // re-measures the glyph page (FrameProfiler::measureFontPages, once a frame)
+    void release(const void* resource);               // forgets the allocation (and a font's pages)
+    void releaseOwner(const std::string& owner);      // forgets everything an owner holds (it was destroyed)
+    std::string getCurrentOwner() const;              // owner new allocations go to ("Game" outside any scope)
+
+    // -- queries --
+    Usage getTotal() const;
+    Usage getByType(Type type) const;
+    Usage getByOwner(const std::string& owner) const;
+    std::vector<std::string> getOwners() const;       // every owner that ever held something
+    static const char* getTypeName(Type type);
+
+    // -- dump --
+    std::string dump() const;                         // totals per type and owner plus the largest allocations
+    void writeDump(const std::string& path) const;    // writes dump() to a file on the job system
+
+    MemoryTracker(const MemoryTracker&) = delete;
+    MemoryTracker& operator=(const MemoryTracker&) = delete;
+
+private:
+    // constructor: ensure singleton pattern
+    MemoryTracker() {}
+
+    // one tracked allocation
+    struct Entry {
+        Type type;
+        std::string owner;
+        unsigned int generation;                      // which instance of the owner made it
+        std::string name;                             // file path (or path plus character size for font pages)
+        std::uint64_t bytes;
+    };
+
+    using Key = std::pair<const void*, unsigned int>; // resource address, character size for font pages (0 otherwise)
+
+    mutable std::mutex trackerMutex;                  // prefetch jobs track from worker threads
+    std::map<Key, Entry> entries;
+    Usage total;
+    Usage byType[static_cast<int>(Type::Count)];
+    std::map<std::string, Usage> byOwner;
+    std::map<std::string, unsigned int> ownerGenerations; // latest instance of every owner
+    std::string currentOwner = "Game";
+    unsigned int currentGeneration = 0;
+    unsigned int nextGeneration = 1;
+
+    // all below expect trackerMutex to be held
+    void add(const Key& key, Entry entry);            // replaces an existing entry for the same key
+    void remove(std::map<Key, Entry>::iterator it);
+    void releaseOlder(const std::string& owner, unsigned int generation);
+};
+
+#endif
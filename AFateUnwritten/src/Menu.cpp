@@ -1,15 +1,14 @@
 #include "Menu.h"
 #include "ResizeManager.h"
-#include "LoadResources.h"
+#include "Input.h"
+#include "FrameProfiler.h"
 
 using namespace sf;
 
 // constructor for the Menu class
-Menu::Menu(RenderWindow& window) : Scene(window), selectedItemIndex(0) {
-    // load fonts for title and menu items
-    resourceLoader(titleFont, "resources/fonts/MTCORSVA.ttf");
-    resourceLoader(font, "resources/fonts/CALIFR.ttf");
-
+// the fonts' atlases are built on first use and shared, every window size draws from them
+Menu::Menu(RenderTarget& window) : Scene(window), selectedItemIndex(0),
+    font(SdfFont::get("resources/fonts/CALIFR.ttf")), titleFont(SdfFont::get("resources/fonts/MTCORSVA.ttf")) {
     // resize and position elements
     resize();
 
@@ -33,7 +32,7 @@ void Menu::resize() {
     title.setCharacterSize(static_cast<unsigned int>(scaledTitleSize));
     title.setFillColor(Color::White);
     title.setStyle(Text::Bold);
-    title.setString("A Fate Unwritten");
+    FrameProfiler::setString(title, "A Fate Unwritten");
 
     // center the title text
     FloatRect titleBounds = title.getLocalBounds();
@@ -60,7 +59,7 @@ void Menu::resize() {
     for (int i = 0; i < 4; i++) {
         menu[i].setFont(font);
         menu[i].setCharacterSize(static_cast<unsigned int>(scaledTextSize));
-        menu[i].setString(labels[i]);
+        FrameProfiler::setString(menu[i], labels[i]);
 
         // highlight the selected item, otherwise keep it white
         menu[i].setFillColor((selectedItemIndex == i) ? Color(139, 0, 0) : Color::White);
@@ -91,7 +90,7 @@ void Menu::update() {
     gifAnimator.update(); // update background animation
 
     // get the mouse position relative to the window
-    Vector2i mousePos = Mouse::getPosition(window);
+    Vector2i mousePos = Input::getInstance().getMousePosition();
     Vector2f mousePosF(static_cast<float>(mousePos.x), static_cast<float>(mousePos.y));
 
     // reset all menu items to default colour(white)
@@ -100,7 +99,7 @@ void Menu::update() {
         menu[i].setStyle(Text::Bold);
     }
 
-    bool mousePressed = Mouse::isButtonPressed(Mouse::Left);
+    bool mousePressed = Input::getInstance().isMouseButtonPressed(Mouse::Left);
 
     // check if the mouse is hovering over any menu item
     for (int i = 0; i < 4; i++) {
@@ -128,20 +127,19 @@ void Menu::render() {
     // always draw the GIF, even if it's finished  so it loops.
     gifAnimator.draw(window);
 
-    window.draw(title);
+    FrameProfiler::draw(window, title);
 
     // draw each menu option
     for (int i = 0; i < 4; i++) {
-        window.draw(menu[i]);
+        FrameProfiler::draw(window, menu[i]);
     }
-    window.display();
 }
 
 // reset the menu to initial state
 void Menu::reset() {
     selectedItemIndex = -1;
     selectionMade = false;
-    mousePreviouslyPressed = Mouse::isButtonPressed(Mouse::Left);  // set to current state on reset
+    mousePreviouslyPressed = Input::getInstance().isMouseButtonPressed(Mouse::Left);  // set to current state on reset
 }
 
 // change the body to have it as marked "complete" if selection is made
@@ -5,6 +5,7 @@
 #include "SFML/Graphics.hpp"
 #include "Scene.h"
 #include "GifAnimator.h" 
+#include "SdfText.h"
 
 // maximum number of items in the menu
 #define MAX_NUMBER_OF_ITEMS 4
@@ -13,7 +14,7 @@
 class Menu : public Scene<Menu> { // inherits from Scene<Menu> to be a specialized scene
 public:
     // -- constructor and destructor --
-    Menu(sf::RenderWindow& window);          // constructor that initializes the window reference
+    Menu(sf::RenderTarget& window);          // constructor that initializes the window reference
     // -- public member functions --
     int getPressedItem() const { return selectedItemIndex; } // returns the index of the currently selected menu item
     void loadResources() override;           // loads necessary resources, like background image
@@ -22,6 +23,7 @@ public:
     void reset() override;                   // resets the menu (if needed)
     bool isTextComplete() const override;    // checks if the menu text display is complete
     void resize();                           // adjusts layout for different window sizes
+    sf::FloatRect getItemBounds(int index) const { return menu[index].getGlobalBounds(); } // on-screen area of a menu item
 
 private:
     // -- private member variables --
@@ -29,10 +31,10 @@ private:
     bool selectionMade = false;              // flag to track if an item has been selected
     sf::Texture backgroundTexture;           // texture for the menu background
     sf::Sprite backgroundSprite;             // sprite for the menu background
-    sf::Font font;                           // font used for menu text
-    sf::Text menu[MAX_NUMBER_OF_ITEMS];      // array of text objects for each menu item
-    sf::Text title;                          // title text of the menu
-    sf::Font titleFont;                      // font for the title text
+    const SdfFont& font;                     // font used for menu text
+    SdfText menu[MAX_NUMBER_OF_ITEMS];       // array of text objects for each menu item
+    SdfText title;                           // title text of the menu
+    const SdfFont& titleFont;                // font for the title text
     GifAnimator gifAnimator = GifAnimator("resources/home/home_screen_", 66); // gif animator for home screen animation
     bool playGif = false;                    // flag to indicate whether the gif is being played
     bool mousePreviouslyPressed = false;     // tracks if the mouse was pressed previously
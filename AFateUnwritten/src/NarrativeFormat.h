@@ -0,0 +1,95 @@
+#ifndef NARRATIVE_FORMAT_H
+#define NARRATIVE_FORMAT_H
+
+// Standard Library Includes
+#include <cstdint>
+
+// layout of resources/narrative/narrative.bin, written by tools/NarrativeCompiler and mapped by NarrativeStore
+// the header is followed by the sequence, line, trigger, layout, line chunks, chunk, automaton, class, state,
+// transition and match records, then the string table. every field is a little-endian uint32 and every string
+// is an (offset, length) pair into the string table (each text is stored once)
+namespace NarrativeFormat {
+    const std::uint32_t magic = 0x524E4641;     // "AFNR"
+    const std::uint32_t version = 3;            // bump when a record changes
+
+    // speaker names in the order of Dialogue::DialogueType (a line record stores the index)
+    const char* const speakerNames[] = { "Narrator", "Dorothy", "Lion", "Scarecrow", "Tinman", "Wizard" };
+    const std::uint32_t speakerCount = sizeof(speakerNames) / sizeof(speakerNames[0]);
+
+    struct StringRef {
+        std::uint32_t offset;                   // from the start of the string table
+        std::uint32_t length;
+    };
+
+    struct Header {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint32_t sequenceCount;
+        std::uint32_t lineCount;
+        std::uint32_t triggerCount;
+        std::uint32_t layoutCount;
+        std::uint32_t chunkCount;
+        std::uint32_t automatonCount;           // one per chapter with triggers
+        std::uint32_t classCount;               // 256 per automaton
+        std::uint32_t stateCount;
+        std::uint32_t transitionCount;
+        std::uint32_t matchCount;
+        std::uint32_t stringTableOffset;        // from the start of the file
+        std::uint32_t stringTableSize;
+    };
+
+    // a named run of lines, "chapter.sequence" (e.g. "lion.start")
+    struct SequenceRecord {
+        StringRef name;
+        std::uint32_t firstLine;
+        std::uint32_t lineCount;
+    };
+
+    struct LineRecord {
+        std::uint32_t speaker;                  // index into speakerNames
+        StringRef text;
+    };
+
+    // background change of a chapter: image shown once the phrase is on screen
+    struct TriggerRecord {
+        StringRef chapter;
+        StringRef phrase;
+        StringRef imagePath;
+    };
+
+    // every line pre-wrapped for one window size: lineCount LineChunksRecords starting at firstLine
+    // (in line order), each naming its chunks. only valid for the font the compiler measured with
+    struct LayoutRecord {
+        std::uint32_t windowWidth;
+        std::uint32_t windowHeight;
+        std::uint32_t characterSize;
+        std::uint32_t firstLine;                // into the line chunks records
+    };
+
+    struct LineChunksRecord {
+        std::uint32_t firstChunk;               // into the chunk records (each a StringRef, '\n' between lines)
+        std::uint32_t chunkCount;
+    };
+
+    // a chapter's trigger phrases compiled into a DFA (Aho-Corasick with every failure link resolved), see
+    // TriggerAutomaton. the chapter's triggers are contiguous trigger records, states and triggers are
+    // numbered from 0 within the automaton, state 0 is the start
+    struct AutomatonRecord {
+        StringRef chapter;
+        std::uint32_t firstTrigger;             // into the trigger records
+        std::uint32_t triggerCount;
+        std::uint32_t firstClass;               // 256 class records: byte -> column of the transition table
+        std::uint32_t columnCount;
+        std::uint32_t firstState;               // into the state records
+        std::uint32_t stateCount;
+        std::uint32_t firstTransition;          // stateCount * columnCount records (uint32 next state), row per state
+    };
+
+    // triggers whose phrase ends when the automaton reaches this state
+    struct StateRecord {
+        std::uint32_t firstMatch;               // into the match records (uint32 trigger within the automaton)
+        std::uint32_t matchCount;
+    };
+}
+
+#endif
@@ -0,0 +1,188 @@
+#include "NarrativeStore.h"
+#include "NarrativeFormat.h"
+#include "StartupReport.h"
+#include "Trace.h"
+
+#include <cstring>
+#include <stdexcept>
+
+using namespace std;
+using namespace NarrativeFormat;
+
+static const char* const narrativePath = "resources/narrative/narrative.bin";
+
+// reads a record array out of the mapping after checking it lies inside the file
+template <typename Record>
+static const Record* recordsAt(const MappedFile& file, size_t offset, uint32_t count) {
+    if (offset + static_cast<size_t>(count) * sizeof(Record) > file.size()) {
+        throw runtime_error(string("Truncated narrative file: ") + narrativePath);
+    }
+    return reinterpret_cast<const Record*>(file.data() + offset);
+}
+
+// singleton: get the single instance of NarrativeStore
+NarrativeStore& NarrativeStore::getInstance() {
+    static NarrativeStore instance;
+    return instance;
+}
+
+// maps the compiled story and builds the views every scene reads through
+NarrativeStore::NarrativeStore() {
+    Trace::Scope trace("NarrativeStore", "load", narrativePath);
+    StartupReport::Phase phase(StartupReport::Kind::Other, narrativePath);
+    file = MappedFile(narrativePath);
+
+    Header header;
+    if (file.size() < sizeof(header)) {
+        throw runtime_error(string("Truncated narrative file: ") + narrativePath);
+    }
+    memcpy(&header, file.data(), sizeof(header));
+    if (header.magic != magic || header.version != NarrativeFormat::version) {
+        throw runtime_error(string("Narrative file is from another version, rebuild it with NarrativeCompiler: ") + narrativePath);
+    }
+    if (static_cast<size_t>(header.stringTableOffset) + header.stringTableSize > file.size()) {
+        throw runtime_error(string("Truncated narrative file: ") + narrativePath);
+    }
+
+    size_t offset = sizeof(Header);
+    const SequenceRecord* sequenceRecords = recordsAt<SequenceRecord>(file, offset, header.sequenceCount);
+    offset += header.sequenceCount * sizeof(SequenceRecord);
+    const LineRecord* lineRecords = recordsAt<LineRecord>(file, offset, header.lineCount);
+    offset += header.lineCount * sizeof(LineRecord);
+    const TriggerRecord* triggerRecords = recordsAt<TriggerRecord>(file, offset, header.triggerCount);
+    offset += header.triggerCount * sizeof(TriggerRecord);
+    const LayoutRecord* layoutRecords = recordsAt<LayoutRecord>(file, offset, header.layoutCount);
+    offset += header.layoutCount * sizeof(LayoutRecord);
+    const LineChunksRecord* lineChunksRecords = recordsAt<LineChunksRecord>(file, offset, header.layoutCount * header.lineCount);
+    offset += static_cast<size_t>(header.layoutCount) * header.lineCount * sizeof(LineChunksRecord);
+    const StringRef* chunkRecords = recordsAt<StringRef>(file, offset, header.chunkCount);
+    offset += header.chunkCount * sizeof(StringRef);
+    const AutomatonRecord* automatonRecords = recordsAt<AutomatonRecord>(file, offset, header.automatonCount);
+    offset += header.automatonCount * sizeof(AutomatonRecord);
+    const uint32_t* classRecords = recordsAt<uint32_t>(file, offset, header.classCount);
+    offset += header.classCount * sizeof(uint32_t);
+    const StateRecord* stateRecords = recordsAt<StateRecord>(file, offset, header.stateCount);
+    offset += header.stateCount * sizeof(StateRecord);
+    const uint32_t* transitionRecords = recordsAt<uint32_t>(file, offset, header.transitionCount);
+    offset += header.transitionCount * sizeof(uint32_t);
+    const uint32_t* matchRecords = recordsAt<uint32_t>(file, offset, header.matchCount);
+
+    const char* strings = file.data() + header.stringTableOffset;
+    auto view = [&](StringRef ref) {
+        if (static_cast<size_t>(ref.offset) + ref.length > header.stringTableSize) {
+            throw runtime_error(string("Corrupt string in narrative file: ") + narrativePath);
+        }
+        return string_view(strings + ref.offset, ref.length);
+    };
+
+    lines.reserve(header.lineCount);
+    for (uint32_t i = 0; i < header.lineCount; ++i) {
+        if (lineRecords[i].speaker >= speakerCount) {
+            throw runtime_error(string("Unknown speaker in narrative file: ") + narrativePath);
+        }
+        lines.push_back({ static_cast<Dialogue::DialogueType>(lineRecords[i].speaker), view(lineRecords[i].text) });
+        lineByText.emplace(lines.back().text.data(), i);  // identical lines share their text, and their layout
+    }
+
+    for (uint32_t i = 0; i < header.sequenceCount; ++i) {
+        const SequenceRecord& record = sequenceRecords[i];
+        if (static_cast<size_t>(record.firstLine) + record.lineCount > lines.size()) {
+            throw runtime_error(string("Corrupt sequence in narrative file: ") + narrativePath);
+        }
+        sequences[view(record.name)] = Sequence(lines.data() + record.firstLine, record.lineCount);
+    }
+
+    triggers.reserve(header.triggerCount);
+    phrases.reserve(header.triggerCount);
+    for (uint32_t i = 0; i < header.triggerCount; ++i) {
+        const TriggerRecord& record = triggerRecords[i];
+        triggers.push_back({ view(record.chapter), view(record.phrase), view(record.imagePath) });
+        phrases.push_back(triggers.back().phrase);
+    }
+
+    // the automata are used in place, checked once here so a step can never leave its tables
+    for (uint32_t i = 0; i < header.automatonCount; ++i) {
+        const AutomatonRecord& record = automatonRecords[i];
+        bool valid = static_cast<size_t>(record.firstTrigger) + record.triggerCount <= header.triggerCount
+            && static_cast<size_t>(record.firstClass) + 256 <= header.classCount
+            && static_cast<size_t>(record.firstState) + record.stateCount <= header.stateCount && record.stateCount > 0
+            && static_cast<size_t>(record.firstTransition) + static_cast<size_t>(record.stateCount) * record.columnCount <= header.transitionCount;
+        for (uint32_t c = 0; valid && c < 256; ++c) {
+            valid = classRecords[record.firstClass + c] < record.columnCount;
+        }
+        for (uint32_t t = 0; valid && t < record.stateCount * record.columnCount; ++t) {
+            valid = transitionRecords[record.firstTransition + t] < record.stateCount;
+        }
+        for (uint32_t s = 0; valid && s < record.stateCount; ++s) {
+            const StateRecord& state = stateRecords[record.firstState + s];
+            valid = static_cast<size_t>(state.firstMatch) + state.matchCount <= header.matchCount;
+            for (uint32_t m = 0; valid && m < state.matchCount; ++m) {
+                valid = matchRecords[state.firstMatch + m] < record.triggerCount;
+            }
+        }
+        if (!valid) {
+            throw runtime_error(string("Corrupt trigger automaton in narrative file: ") + narrativePath);
+        }
+        automata[view(record.chapter)] = TriggerAutomaton(classRecords + record.firstClass, record.columnCount,
+            transitionRecords + record.firstTransition, stateRecords + record.firstState, matchRecords,
+            phrases.data() + record.firstTrigger, record.triggerCount);
+    }
+
+    chunks.reserve(header.chunkCount);
+    for (uint32_t i = 0; i < header.chunkCount; ++i) {
+        chunks.push_back(view(chunkRecords[i]));
+    }
+
+    layouts.resize(header.layoutCount);
+    for (uint32_t i = 0; i < header.layoutCount; ++i) {
+        const LayoutRecord& record = layoutRecords[i];
+        if (static_cast<size_t>(record.firstLine) + header.lineCount > static_cast<size_t>(header.layoutCount) * header.lineCount) {
+            throw runtime_error(string("Corrupt layout in narrative file: ") + narrativePath);
+        }
+        Layout& layout = layouts[i];
+        layout.windowSize = sf::Vector2u(record.windowWidth, record.windowHeight);
+        layout.characterSize = record.characterSize;
+        layout.lineChunks.reserve(header.lineCount);
+        for (uint32_t line = 0; line < header.lineCount; ++line) {
+            const LineChunksRecord& lineChunks = lineChunksRecords[record.firstLine + line];
+            if (static_cast<size_t>(lineChunks.firstChunk) + lineChunks.chunkCount > chunks.size()) {
+                throw runtime_error(string("Corrupt layout in narrative file: ") + narrativePath);
+            }
+            layout.lineChunks.push_back(Chunks(chunks.data() + lineChunks.firstChunk, lineChunks.chunkCount));
+        }
+    }
+}
+
+NarrativeStore::Sequence NarrativeStore::getSequence(string_view name) const {
+    auto sequence = sequences.find(name);
+    if (sequence == sequences.end()) {
+        throw runtime_error("Narrative sequence missing from " + string(narrativePath) + ": " + string(name));
+    }
+    return sequence->second;
+}
+
+void NarrativeStore::getBackgroundTriggers(string_view chapter, BackgroundManager& bgManager) const {
+    for (const Trigger& trigger : triggers) {
+        if (trigger.chapter == chapter) {
+            bgManager[string(trigger.phrase)] = string(trigger.imagePath);
+        }
+    }
+}
+
+TriggerAutomaton NarrativeStore::getTriggerAutomaton(string_view chapter) const {
+    auto automaton = automata.find(chapter);
+    return automaton == automata.end() ? TriggerAutomaton() : automaton->second;
+}
+
+NarrativeStore::Chunks NarrativeStore::getPrewrappedChunks(string_view text, sf::Vector2u windowSize, unsigned int characterSize) const {
+    auto line = lineByText.find(text.data());
+    if (line == lineByText.end() || lines[line->second].text.size() != text.size()) {
+        return Chunks();
+    }
+    for (const Layout& layout : layouts) {
+        if (layout.windowSize == windowSize && layout.characterSize == characterSize) {
+            return layout.lineChunks[line->second];
+        }
+    }
+    return Chunks();
+}
@@ -0,0 +1,81 @@
+#ifndef NARRATIVE_STORE_H
+#define NARRATIVE_STORE_H
+
+// Standard Library Includes
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// project includes
+#include "Dialogue.h"
+#include "BackgroundManager.h"
+#include "MappedFile.h"
+#include "TriggerAutomaton.h"
+
+// handles: the story text, compiled from resources/narrative/*.story into narrative.bin and mapped at first use
+// lines and sequences are views into the mapping, so scenes hold and pass them around without copying text
+// the compiler also pre-wraps every line for a few standard window sizes, TextManager uses those chunks
+// when the window matches and wraps the text itself otherwise
+class NarrativeStore {
+public:
+    // a run of items owned by the store (cheap to copy, stays valid for the whole game)
+    template <typename T>
+    class View {
+    public:
+        View() {}
+        View(const T* items, std::size_t count) : items(items), count(count) {}
+        const T* begin() const { return items; }
+        const T* end() const { return items + count; }
+        const T& operator[](std::size_t index) const { return items[index]; }
+        std::size_t size() const { return count; }
+        bool empty() const { return count == 0; }
+
+    private:
+        const T* items = nullptr;
+        std::size_t count = 0;
+    };
+    using Sequence = View<Dialogue::DialogueLine>;    // dialogue lines of one sequence
+    using Chunks = View<std::string_view>;            // text box pages of one line
+
+    static NarrativeStore& getInstance();             // singleton pattern: the story is mapped once
+
+    Sequence getSequence(std::string_view name) const; // "chapter.sequence", throws runtime_error if it isn't compiled in
+    void getBackgroundTriggers(std::string_view chapter, BackgroundManager& bgManager) const; // registers a chapter's triggers
+    TriggerAutomaton getTriggerAutomaton(std::string_view chapter) const; // the same triggers, for Dialogue (empty if none)
+
+    // pre-wrapped chunks of a line's text (the view a Sequence handed out), empty when the line wasn't laid
+    // out for this window size and character size (or the text doesn't come from the store)
+    Chunks getPrewrappedChunks(std::string_view text, sf::Vector2u windowSize, unsigned int characterSize) const;
+
+    NarrativeStore(const NarrativeStore&) = delete;
+    NarrativeStore& operator=(const NarrativeStore&) = delete;
+
+private:
+    // constructor: maps and checks narrative.bin (throws runtime_error if it is missing or from another version)
+    NarrativeStore();
+
+    struct Trigger {
+        std::string_view chapter;
+        std::string_view phrase;
+        std::string_view imagePath;
+    };
+
+    // every line wrapped for one window size
+    struct Layout {
+        sf::Vector2u windowSize;
+        unsigned int characterSize;
+        std::vector<Chunks> lineChunks;                             // indexed like lines
+    };
+
+    MappedFile file;
+    std::vector<Dialogue::DialogueLine> lines;                      // all lines, in sequence order
+    std::unordered_map<std::string_view, Sequence> sequences;
+    std::vector<Trigger> triggers;
+    std::vector<std::string_view> phrases;                          // of triggers, what automata point at
+    std::unordered_map<std::string_view, TriggerAutomaton> automata;
+    std::vector<std::string_view> chunks;                           // every layout's chunks
+    std::vector<Layout> layouts;
+    std::unordered_map<const char*, std::size_t> lineByText;        // text address -> index into lines
+};
+
+#endif
@@ -0,0 +1,26 @@
+#ifndef NULL_RENDER_TARGET_H
+#define NULL_RENDER_TARGET_H
+
+// SFML Includes
+#include <SFML/Graphics.hpp>
+
+// render target that reports a fixed size but never activates a GL context,
+// so clear() and draw() return straight away and no GPU work is done
+// note: loading textures and fonts still needs a GL context (e.g. Mesa software GL)
+class NullRenderTarget : public sf::RenderTarget {
+public:
+    // constructor: sets the size scenes will lay themselves out for
+    explicit NullRenderTarget(sf::Vector2u size) : size(size) {
+        initialize();   // sets up the default view for the given size
+    }
+
+    sf::Vector2u getSize() const override { return size; }   // fixed size of the target
+    bool setActive(bool = true) override {                    // refusing activation makes SFML skip all GL calls
+        return false;
+    }
+
+private:
+    sf::Vector2u size;   // pretend size of the target
+};
+
+#endif
@@ -1,6 +1,7 @@
 #include "PauseMenu.h"
 #include "ResizeManager.h"
 #include "LoadResources.h"
+#include "Trace.h"
 #include "ControlScreen.h"
 #include <SFML/Window/Mouse.hpp>
 
@@ -80,6 +81,7 @@ void PauseMenu::updateOptions() {
 
 // main loop for showing the pause menu and handling user input
 PauseMenuChoice PauseMenu::show() {
+    Trace::Scope trace("PauseMenu::show", "modal");
     Event event;
     while (window.isOpen()) {
         while (window.pollEvent(event)) {
@@ -0,0 +1,56 @@
+#ifndef QUESTION_FORMAT_H
+#define QUESTION_FORMAT_H
+
+// Standard Library Includes
+#include <cstddef>
+#include <cstdint>
+
+// project includes
+#include "NarrativeFormat.h"
+
+// layout of resources/narrative/questions.bin, written by tools/NarrativeCompiler from the *.quiz scripts and
+// mapped by QuestionStore. the header is followed by the bank, question and option records, then the string
+// table, with the same conventions as narrative.bin (little-endian uint32 fields, strings as StringRefs)
+namespace QuestionFormat {
+    using NarrativeFormat::StringRef;
+
+    const std::uint32_t magic = 0x42514641;     // "AFQB"
+    const std::uint32_t version = 1;            // bump when a record changes
+
+    struct Header {
+        std::uint32_t magic;
+        std::uint32_t version;
+        std::uint32_t bankCount;
+        std::uint32_t questionCount;
+        std::uint32_t optionCount;
+        std::uint32_t contentHash;              // FNV-1a of everything after the header, identifies the bank contents
+        std::uint32_t stringTableOffset;        // from the start of the file
+        std::uint32_t stringTableSize;
+    };
+
+    // the questions of one chapter, "chapter.bank" (e.g. "scarecrow.questions"), stored contiguously
+    // so a bank is its own index range [firstQuestion, firstQuestion + questionCount)
+    struct BankRecord {
+        StringRef name;
+        std::uint32_t firstQuestion;
+        std::uint32_t questionCount;
+    };
+
+    struct QuestionRecord {
+        StringRef text;
+        std::uint32_t firstOption;              // into the option records (each a StringRef)
+        std::uint32_t optionCount;
+        std::uint32_t correctOption;            // 0 based, within the question's options
+    };
+
+    // FNV-1a, used for contentHash
+    inline std::uint32_t hash(const char* data, std::size_t size) {
+        std::uint32_t value = 2166136261u;
+        for (std::size_t i = 0; i < size; ++i) {
+            value = (value ^ static_cast<unsigned char>(data[i])) * 16777619u;
+        }
+        return value;
+    }
+}
+
+#endif
@@ -1,18 +1,25 @@
 #include "QuestionHandler.h"
 #include "LoadResources.h"
 #include "ResizeManager.h"
+#include "Input.h"
+#include "FrameProfiler.h"
+#include "EventBus.h"
+#include "GameEvents.h"
 #include <algorithm>
 #include <random>
 #include <sstream>  
+#include <utility>
 
 using namespace sf;
 using namespace std;
 
 // constructor: initializes fonts and text for question and score texts, and loads button sound
-QuestionHandler::QuestionHandler(RenderWindow& window)
+QuestionHandler::QuestionHandler(RenderTarget& window)
     : window(window),
-    nextButton(window, "Next", font, Vector2f(window.getSize().x - 150, window.getSize().y - 80), Vector2f(120, 60), true) {
-    resourceLoader(font, "resources/fonts/INFROMAN.ttf");
+    nextButton(window, "Next", SdfFont::get(SdfFont::uiFontPath), Vector2f(window.getSize().x - 150, window.getSize().y - 80), Vector2f(120, 60), true) {
+    resourceLoader(font, SdfFont::uiFontPath);  // same face for the question and score text
+    measureText.setFont(font);
+    measureLabel.setFont(SdfFont::get(SdfFont::uiFontPath));
     // set up question text
     questionText.setFont(font);
     questionText.setCharacterSize(42);
@@ -35,119 +42,170 @@ QuestionHandler::QuestionHandler(RenderWindow& window)
     resize();
 }
 
-void QuestionHandler::setQuestions(const vector<Question>& newQuestions) {
-    questions = newQuestions; // initialize questions
+void QuestionHandler::setQuestions(vector<Question> newQuestions) {
+    questions = move(newQuestions); // initialize questions
+    questionsChanged();
 }
 
 void QuestionHandler::selectRandomQuestions(int count) {
     if (questions.empty()) return;
 
-    // generate a random seed
-    random_device rd;
-    mt19937 g(rd()); // randomizer engine - Mersenne Twister
+    // shared randomizer engine (Mersenne Twister), its seed is part of an input recording
+    mt19937& g = Input::getInstance().getRandomEngine();
 
-    // shuffle and select the first 'count' questions
-    shuffle(questions.begin(), questions.end(), g);
-
-    if (count < static_cast<int>(questions.size())) {
-        questions.resize(count);
+    // partial Fisher-Yates: only the first 'count' slots get shuffled, then the rest is dropped
+    const size_t kept = min(questions.size(), static_cast<size_t>(max(count, 0)));
+    for (size_t i = 0; i < kept; ++i) {
+        uniform_int_distribution<size_t> pick(i, questions.size() - 1);
+        swap(questions[i], questions[pick(g)]);
     }
+    questions.resize(kept);
+    questionsChanged();
 }
 
-// resets quiz to its initial state:
-void QuestionHandler::reset() {
-    currentQuestionIndex = 0;
-    score = 0;
-    selectedIndex = -1;
-    _isComplete = false;
-    loadCurrentQuestion(); // load the first question to start the quiz fresh
-    updateScoreText(); // current question will be set to one and score to zero
+// the bank changed: layouts are precomputed for the current window size and the button pool
+// grows to the largest option count, so moving between questions only re-labels buttons
+void QuestionHandler::questionsChanged() {
+    layouts.clear();
+
+    size_t mostOptions = 0;
+    for (const auto& question : questions) {
+        mostOptions = max(mostOptions, question.options.size());
+    }
+    buttons.reserve(mostOptions);
+    while (buttons.size() < mostOptions) {
+        buttons.emplace_back(window, "", SdfFont::get(SdfFont::uiFontPath), Vector2f(0, 0), Vector2f(0, 0), false, currentLevelType);
+    }
+    activeButtons = 0;
+
+    getLayouts();
 }
 
-void QuestionHandler::loadCurrentQuestion() {
-    if (currentQuestionIndex >= static_cast<int>(questions.size())) { // if all questions are answered
-        _isComplete = true; // then  mark quiz as complete
-        return;
+// returns the layouts for the current window size, computing every question's on the first request
+const vector<QuestionHandler::QuestionLayout>& QuestionHandler::getLayouts() {
+    WindowSize size(window.getSize().x, window.getSize().y);
+    auto cached = layouts.find(size);
+    ++layoutUses;
+    if (cached != layouts.end()) {
+        cached->second.lastUse = layoutUses;
+        return cached->second.questions;
     }
 
+    if (layouts.size() >= 4) {  // a drag-resize passes many sizes, only the last few are worth keeping
+        layouts.erase(min_element(layouts.begin(), layouts.end(), [](const auto& a, const auto& b) {
+            return a.second.lastUse < b.second.lastUse;
+        }));
+    }
     const Vector2f scale = ResizeManager::getScale(window);
-    const auto& currentQuestion = questions[currentQuestionIndex]; // get reference to current question
+    SizedLayouts& entry = layouts[size];
+    entry.lastUse = layoutUses;
+    vector<QuestionLayout>& sized = entry.questions;
+    sized.reserve(questions.size());
+    for (const auto& question : questions) {
+        sized.push_back(computeLayout(question, scale));
+    }
+    return sized;
+}
 
-    // set up question text 
-    questionText.setString(currentQuestion.question);
-    questionText.setCharacterSize(ResizeManager::scaleText(42, scale.y));
+// measures the question and its options and places the box, text and buttons
+QuestionHandler::QuestionLayout QuestionHandler::computeLayout(const Question& question, Vector2f scale) {
+    QuestionLayout layout;
+    layout.textSize = static_cast<unsigned int>(ResizeManager::scaleText(42, scale.y));
 
     // calculate question box dimensions with padding
+    FrameProfiler::setString(measureText, question.question);
+    measureText.setCharacterSize(layout.textSize);
     const float padding = 40 * scale.x;
-    const auto bounds = questionText.getLocalBounds();
+    const auto bounds = measureText.getLocalBounds();
 
     // position the question box
-    questionBox.setSize(Vector2f(bounds.width + padding, bounds.height + padding));
-    questionBox.setPosition((window.getSize().x - questionBox.getSize().x) / 2, 20 * scale.y);
-    questionBox.setFillColor(Color(137, 207, 240, 180));
+    layout.boxSize = Vector2f(bounds.width + padding, bounds.height + padding);
+    layout.boxPosition = Vector2f((window.getSize().x - layout.boxSize.x) / 2, 20 * scale.y);
 
     // position question text within the box:
-    questionText.setPosition(
-        questionBox.getPosition().x + 20 * scale.x,
-        questionBox.getPosition().y + 20 * scale.y
-    );
+    layout.textPosition = Vector2f(layout.boxPosition.x + 20 * scale.x, layout.boxPosition.y + 20 * scale.y);
 
-    buttons.clear();
-    selectedIndex = -1;
-    // calculate maximum button width needed for options
+    // calculate maximum button width needed for options (measured the way Button draws its label)
     float maxButtonWidth = 0;
-    for (const auto& option : currentQuestion.options) {
-        Text temp;
-        temp.setFont(font);
-        temp.setString(option);
-        temp.setCharacterSize(ResizeManager::scaleText(36, scale.y));
-        maxButtonWidth = max(maxButtonWidth, temp.getLocalBounds().width);
+    measureLabel.setCharacterSize(static_cast<unsigned int>(ResizeManager::scaleText(36, scale.y)));
+    for (const auto& option : question.options) {
+        FrameProfiler::setString(measureLabel, option);
+        maxButtonWidth = max(maxButtonWidth, measureLabel.getLocalBounds().width);
     }
     // set button dimensions with padding
-    const float buttonWidth = maxButtonWidth + 40 * scale.x;
-    const float buttonHeight = 90 * scale.y;
-    const float centerX = (window.getSize().x - buttonWidth) / 2;
+    layout.buttonSize = Vector2f(maxButtonWidth + 40 * scale.x, 90 * scale.y);
+    layout.buttonX = (window.getSize().x - layout.buttonSize.x) / 2;
 
     // to center buttons between the bottom of question box and bottom of screen
     const float spacing = 20 * scale.y;  // space between buttons
-    const float totalHeight = currentQuestion.options.size() * buttonHeight +
-        (currentQuestion.options.size() - 1) * spacing;
+    const float totalHeight = question.options.size() * layout.buttonSize.y +
+        (question.options.size() - 1) * spacing;
 
-    const float availableTop = questionBox.getPosition().y + questionBox.getSize().y;
+    const float availableTop = layout.boxPosition.y + layout.boxSize.y;
     const float availableBottom = window.getSize().y;
     const float verticalSpace = availableBottom - availableTop;
 
-    const float startY = availableTop + (verticalSpace - totalHeight) / 2;
-    // create buttons for each answer option, add to button vector
-    for (size_t i = 0; i < currentQuestion.options.size(); i++) {
-        buttons.emplace_back(
-            window,                     // reference to game window
-            currentQuestion.options[i], // option text
-            font,                      // font to use
-            Vector2f(centerX, startY + i * (buttonHeight + spacing)), // position
-            Vector2f(buttonWidth, buttonHeight), // size
-            false,                    // initial hover state
-            currentLevelType           // level-specific button colour
+    layout.firstButtonY = availableTop + (verticalSpace - totalHeight) / 2;
+    layout.buttonStep = layout.buttonSize.y + spacing;
+    return layout;
+}
+
+// resets quiz to its initial state:
+void QuestionHandler::reset() {
+    currentQuestionIndex = 0;
+    score = 0;
+    selectedIndex = -1;
+    _isComplete = false;
+    loadCurrentQuestion(); // load the first question to start the quiz fresh
+    updateScoreText(); // current question will be set to one and score to zero
+}
+
+void QuestionHandler::loadCurrentQuestion() {
+    if (currentQuestionIndex >= static_cast<int>(questions.size())) { // if all questions are answered
+        _isComplete = true; // then  mark quiz as complete
+        return;
+    }
+
+    const auto& currentQuestion = questions[currentQuestionIndex]; // get reference to current question
+    const QuestionLayout& layout = getLayouts()[currentQuestionIndex];  // measured when the bank was loaded
+
+    // set up question text and the box around it
+    FrameProfiler::setString(questionText, currentQuestion.question);
+    questionText.setCharacterSize(layout.textSize);
+    questionText.setPosition(layout.textPosition);
+    questionBox.setSize(layout.boxSize);
+    questionBox.setPosition(layout.boxPosition);
+    questionBox.setFillColor(Color(137, 207, 240, 180));
+
+    selectedIndex = -1;
+    // re-label one pooled button per answer option
+    activeButtons = static_cast<int>(currentQuestion.options.size());
+    for (int i = 0; i < activeButtons; i++) {
+        buttons[i].setLabel(
+            currentQuestion.options[i],                                 // option text
+            Vector2f(layout.buttonX, layout.firstButtonY + i * layout.buttonStep), // position
+            layout.buttonSize,                                          // size
+            currentLevelType                                            // level-specific button colour
         );
     }
 }
 
 void QuestionHandler::update() {
-    Vector2f mousePos = static_cast<Vector2f>(Mouse::getPosition(window));
-    bool mouseClicked = Mouse::isButtonPressed(Mouse::Left);
+    Vector2f mousePos = static_cast<Vector2f>(Input::getInstance().getMousePosition());
+    bool mouseClicked = Input::getInstance().isMouseButtonPressed(Mouse::Left);
 
     // handle answer buttons
-    for (size_t i = 0; i < buttons.size(); i++) {
+    for (int i = 0; i < activeButtons; i++) {
         Button& button = buttons[i];
 
         if (button.contains(mousePos)) {
             button.setHover(true); // highlight button currently under mouse
 
-            if (mouseClicked && selectedIndex != static_cast<int>(i)) { // only update if selecting a new button
+            if (mouseClicked && selectedIndex != i) { // only update if selecting a new button
                 if (selectedIndex != -1) {
                     buttons[selectedIndex].deselect(); // deselect previous selection (if any)
                 }
-                selectedIndex = static_cast<int>(i); // update selection to clicked button i
+                selectedIndex = i; // update selection to clicked button i
                 button.select(); // highlight new selection
 
                 //  play click sound when selecting an answer
@@ -169,9 +227,11 @@ void QuestionHandler::update() {
             //  play click sound when pressing "Next"
             button.play();
 
-            if (selectedIndex == questions[currentQuestionIndex].correctOptionIndex) {
+            const bool correct = selectedIndex == questions[currentQuestionIndex].correctOptionIndex;
+            if (correct) {
                 score++;
             }
+            EventBus::getInstance().publish(AnswerSubmitted{ scoreType, currentQuestionIndex, correct, score });
             // go to next question
             currentQuestionIndex++;
             // update display with new score and question number
@@ -181,6 +241,7 @@ void QuestionHandler::update() {
             }
             else { // or complete if done
                 _isComplete = true;
+                EventBus::getInstance().publish(QuizCompleted{ scoreType, score });
             }
             // reset selection
             selectedIndex = -1;
@@ -191,16 +252,37 @@ void QuestionHandler::update() {
     }
 }
 
-void QuestionHandler::draw(RenderWindow& window) {
+SceneSnapshot::Quiz QuestionHandler::getQuizState() const {
+    SceneSnapshot::Quiz state;
+    state.question = currentQuestionIndex;
+    state.selected = selectedIndex;
+    state.score = score;
+    state.complete = _isComplete;
+    return state;
+}
+
+void QuestionHandler::setQuizState(const SceneSnapshot::Quiz& state) {
+    currentQuestionIndex = clamp(state.question, 0, static_cast<int>(questions.size()));
+    score = clamp(state.score, 0, currentQuestionIndex);
+    _isComplete = state.complete;
+    loadCurrentQuestion();   // also clears the selection
+    if (!_isComplete && state.selected >= 0 && state.selected < activeButtons) {
+        selectedIndex = state.selected;
+        buttons[selectedIndex].select();
+    }
+    updateScoreText();
+}
+
+void QuestionHandler::draw(RenderTarget& window) {
     // draws the question, answer options, score , next button to the screen
-    window.draw(backgroundSprite);
-    window.draw(questionBox);
-    window.draw(questionText);
+    FrameProfiler::draw(window, backgroundSprite);
+    FrameProfiler::draw(window, questionBox);
+    FrameProfiler::draw(window, questionText);
     nextButton.draw(window);
-    window.draw(scoreText);
+    FrameProfiler::draw(window, scoreText);
 
-    for (auto& button : buttons) {
-        button.draw(window);
+    for (int i = 0; i < activeButtons; i++) {
+        buttons[i].draw(window);
     }
 }
 
@@ -223,7 +305,7 @@ void QuestionHandler::updateReportLayout(Color c) {
     progressText.setFont(font);
     progressText.setCharacterSize(ResizeManager::scaleText(40, scale.y));
     progressText.setFillColor(Color::White);
-    progressText.setString(report);
+    FrameProfiler::setString(progressText, report);
 
     // position text with padding based on scale
     progressText.setPosition(
@@ -253,14 +335,14 @@ void QuestionHandler::progressReport(Color c, int l) {
 
     report = reportStream.str();
     updateReportLayout(c);
-    window.draw(box);
-    window.draw(progressText);
+    FrameProfiler::draw(window, box);
+    FrameProfiler::draw(window, progressText);
 }
 
 void QuestionHandler::updateScoreText() { // update current question and score to display
     string displayText =
         "Question: " + to_string(currentQuestionIndex + 1) + "/" + to_string(questions.size()) + " | Score:  " + to_string(score);
-    scoreText.setString(displayText);
+    FrameProfiler::setString(scoreText, displayText);
 }
 
 void QuestionHandler::loadSound(SoundBuffer& soundBuffer, const string& filename, Sound& sound) {
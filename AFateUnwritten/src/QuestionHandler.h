@@ -6,9 +6,14 @@
 #include <SFML/Audio.hpp>
 #include <vector>
 #include <string>
+#include <map>
+#include <utility>
 
 // project includes
 #include "Button.h"
+#include "SdfText.h"
+#include "GameScore.h"
+#include "SceneSnapshot.h"
 
 // represents the quiz/question system : handles question management/rendering , scoring , progress reports
 class QuestionHandler {
@@ -21,17 +26,17 @@ public:
     };
 
     // -- constructor --
-    QuestionHandler(sf::RenderWindow& window);
+    QuestionHandler(sf::RenderTarget& window);
 
     // -- question initialization --
-    void setQuestions(const std::vector<Question>& newQuestions);    // load set of questions
-    void selectRandomQuestions(int count);                           // shuffle and resize questions
+    void setQuestions(std::vector<Question> newQuestions);           // load set of questions (moved in, not copied)
+    void selectRandomQuestions(int count);                           // keep count random questions, in random order
 
     // -- quiz operation --
     void reset();                                                    // reset quiz state
     void loadCurrentQuestion();                                      // load the current question and set up buttons
     void update();                                                   // handle quiz logic (button clicks, scores counter update)
-    void draw(sf::RenderWindow& window);                             // render all elements
+    void draw(sf::RenderTarget& window);                             // render all elements
     void updateScoreText();                                          // update the score display
 
     // -- progress report --
@@ -44,8 +49,22 @@ public:
     // -- scoring --
     int getScore() const { return score; }                           // get current score
 
+    // -- save and resume --
+    SceneSnapshot::Quiz getQuizState() const;                        // current question, selection, score and completion
+    void setQuizState(const SceneSnapshot::Quiz& state);             // picks the quiz up there (same questions set beforehand)
+
+    // -- automation (scripted playthroughs click through these) --
+    int getOptionCount() const { return activeButtons; }                           // answer buttons on screen
+    sf::FloatRect getOptionBounds(int index) const { return buttons[index].getBounds(); } // on-screen area of an answer
+    sf::FloatRect getNextBounds() const { return nextButton.getBounds(); }         // on-screen area of "Next"
+    int getSelectedIndex() const { return selectedIndex; }                         // chosen answer (-1 if none yet)
+    int getCorrectOptionIndex() const {                                             // right answer of the current question
+        return currentQuestionIndex < static_cast<int>(questions.size()) ? questions[currentQuestionIndex].correctOptionIndex : -1;
+    }
+
     // -- UI customization --
     void setButtonColor(LevelType type) { currentLevelType = type; } // set level-specific button colour
+    void setScoreType(GameScore::ScoreType type) { scoreType = type; } // score the answers are published for
     void resize();
 
 private:
@@ -59,9 +78,37 @@ private:
     std::string report;                     // progress report text
     sf::RectangleShape box;                 // box to hold progress report
     sf::Text progressText;                  // formatted progress text display
-    std::vector<Button> buttons;            // vector for answer option buttons
+    std::vector<Button> buttons;            // pool of answer buttons, sized to the most options in the bank
+    int activeButtons = 0;                  // pooled buttons used by the current question
     Button nextButton;                      // "Next" button to proceed to next question
 
+    // -- layout cache --
+    // where one question's box, text and answer buttons go at one window size
+    struct QuestionLayout {
+        unsigned int textSize;              // scaled question character size
+        sf::Vector2f boxSize;               // question box
+        sf::Vector2f boxPosition;
+        sf::Vector2f textPosition;          // question text inside the box
+        sf::Vector2f buttonSize;            // every answer button of the question has the same size
+        float buttonX;                      // left edge of the answer buttons
+        float firstButtonY;                 // top of the first answer button
+        float buttonStep;                   // button height plus spacing
+    };
+    using WindowSize = std::pair<unsigned int, unsigned int>;
+    // one layout per question, for the last few window sizes (the least recently shown one makes room)
+    struct SizedLayouts {
+        std::vector<QuestionLayout> questions;
+        unsigned int lastUse = 0;           // layoutUses when the size was last shown
+    };
+    std::map<WindowSize, SizedLayouts> layouts;
+    unsigned int layoutUses = 0;            // counts lookups, orders the sizes by last use
+    sf::Text measureText;                   // reused to measure questions while building layouts
+    SdfText measureLabel;                   // reused to measure options, in the buttons' own font and metrics
+
+    const std::vector<QuestionLayout>& getLayouts();             // layouts for the current window size (built on first use)
+    QuestionLayout computeLayout(const Question& question, sf::Vector2f scale);
+    void questionsChanged();                // drops cached layouts, grows the button pool, lays out the current size
+
     // -- quiz state --
     std::vector<Question> questions;        // vector for question bank
     int currentQuestionIndex = 0;           // keeps track of which question is active
@@ -69,9 +116,10 @@ private:
     int score = 0;                          // correct answer count
     int requiredScore[2] = { 4, 8 };        // scores needed to pass for each level type
 
-    sf::RenderWindow& window;               // reference to game window
+    sf::RenderTarget& window;               // reference to game window
     bool _isComplete = false;               // tracks if all questions are answered
     LevelType currentLevelType;             // current level type (determines button colours)
+    GameScore::ScoreType scoreType = GameScore::TOTALSCORE; // sent with AnswerSubmitted/QuizCompleted (TOTALSCORE: counts for nothing)
     void updateReportLayout(sf::Color c);   // update progress report format
 
     // sound for button clicks
@@ -0,0 +1,223 @@
+#include "QuestionStore.h"
+#include "Input.h"
+#include "ResourceStats.h"
+#include "StartupReport.h"
+#include "Trace.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+using namespace std;
+using namespace QuestionFormat;
+
+static const char* const questionsPath = "resources/narrative/questions.bin";
+static const char* const seenPath = "questions_seen.dat";
+
+// questions_seen.dat: this header, then one bit per question of questions.bin (bit i % 8 of byte i / 8)
+struct SeenHeader {
+    uint32_t magic;
+    uint32_t contentHash;                   // of the questions.bin the bits belong to
+    uint32_t questionCount;
+};
+static const uint32_t seenMagic = 0x53514641;   // "AFQS"
+
+// reads a record array out of the mapping after checking it lies inside the file
+template <typename Record>
+static const Record* recordsAt(const MappedFile& file, size_t offset, uint32_t count) {
+    if (offset + static_cast<size_t>(count) * sizeof(Record) > file.size()) {
+        throw runtime_error(string("Truncated question file: ") + questionsPath);
+    }
+    return reinterpret_cast<const Record*>(file.data() + offset);
+}
+
+// singleton: get the single instance of QuestionStore
+QuestionStore& QuestionStore::getInstance() {
+    static QuestionStore instance;
+    return instance;
+}
+
+// maps the compiled banks, only the bank index is read up front
+QuestionStore::QuestionStore() {
+    Trace::Scope trace("QuestionStore", "load", questionsPath);
+    StartupReport::Phase phase(StartupReport::Kind::Other, questionsPath);
+    JobSystem::getInstance();  // created first so it outlives the store and finishes its last write
+    file = MappedFile(questionsPath);
+
+    Header header;
+    if (file.size() < sizeof(header)) {
+        throw runtime_error(string("Truncated question file: ") + questionsPath);
+    }
+    memcpy(&header, file.data(), sizeof(header));
+    if (header.magic != magic || header.version != QuestionFormat::version) {
+        throw runtime_error(string("Question file is from another version, rebuild it with NarrativeCompiler: ") + questionsPath);
+    }
+    if (static_cast<size_t>(header.stringTableOffset) + header.stringTableSize > file.size()) {
+        throw runtime_error(string("Truncated question file: ") + questionsPath);
+    }
+
+    size_t offset = sizeof(Header);
+    const BankRecord* bankRecords = recordsAt<BankRecord>(file, offset, header.bankCount);
+    offset += header.bankCount * sizeof(BankRecord);
+    questionRecords = recordsAt<QuestionRecord>(file, offset, header.questionCount);
+    offset += header.questionCount * sizeof(QuestionRecord);
+    optionRecords = recordsAt<StringRef>(file, offset, header.optionCount);
+
+    contentHash = header.contentHash;
+    questionCount = header.questionCount;
+    optionCount = header.optionCount;
+    strings = string_view(file.data() + header.stringTableOffset, header.stringTableSize);
+
+    for (uint32_t i = 0; i < header.bankCount; ++i) {
+        const BankRecord& record = bankRecords[i];
+        if (static_cast<size_t>(record.firstQuestion) + record.questionCount > questionCount
+            || static_cast<size_t>(record.name.offset) + record.name.length > strings.size()) {
+            throw runtime_error(string("Corrupt bank in question file: ") + questionsPath);
+        }
+        Bank& bank = banks[strings.substr(record.name.offset, record.name.length)];
+        bank.firstQuestion = record.firstQuestion;
+        bank.questionCount = record.questionCount;
+    }
+
+    loadSeen();
+}
+
+// builds a QuestionHandler question from its records (the only place question text is copied)
+QuestionHandler::Question QuestionStore::makeQuestion(uint32_t index) const {
+    auto text = [&](StringRef ref) {
+        if (static_cast<size_t>(ref.offset) + ref.length > strings.size()) {
+            throw runtime_error(string("Corrupt string in question file: ") + questionsPath);
+        }
+        return string(strings.substr(ref.offset, ref.length));
+    };
+
+    const QuestionRecord& record = questionRecords[index];
+    if (static_cast<size_t>(record.firstOption) + record.optionCount > optionCount || record.correctOption >= record.optionCount) {
+        throw runtime_error(string("Corrupt question in question file: ") + questionsPath);
+    }
+    QuestionHandler::Question question;
+    question.question = text(record.text);
+    question.options.reserve(record.optionCount);
+    for (uint32_t option = 0; option < record.optionCount; ++option) {
+        question.options.push_back(text(optionRecords[record.firstOption + option]));
+    }
+    question.correctOptionIndex = static_cast<int>(record.correctOption);
+    return question;
+}
+
+vector<QuestionHandler::Question> QuestionStore::getBank(string_view name) const {
+    auto bank = banks.find(name);
+    if (bank == banks.end()) {
+        throw runtime_error("Question bank missing from " + string(questionsPath) + ": " + string(name));
+    }
+    vector<QuestionHandler::Question> questions;
+    questions.reserve(bank->second.questionCount);
+    for (uint32_t i = 0; i < bank->second.questionCount; ++i) {
+        questions.push_back(makeQuestion(bank->second.firstQuestion + i));
+    }
+    return questions;
+}
+
+vector<QuestionHandler::Question> QuestionStore::getQuestions(const vector<uint32_t>& indices) const {
+    vector<QuestionHandler::Question> questions;
+    questions.reserve(indices.size());
+    for (uint32_t index : indices) {
+        if (index >= questionCount) {
+            throw runtime_error("Question missing from " + string(questionsPath) + ": " + to_string(index));
+        }
+        questions.push_back(makeQuestion(index));
+    }
+    return questions;
+}
+
+vector<QuestionHandler::Question> QuestionStore::drawUnseen(string_view name, int count, mt19937& random) {
+    return getQuestions(drawUnseenIndices(name, count, random));
+}
+
+vector<uint32_t> QuestionStore::drawUnseenIndices(string_view name, int count, mt19937& random) {
+    auto found = banks.find(name);
+    if (found == banks.end()) {
+        throw runtime_error("Question bank missing from " + string(questionsPath) + ": " + string(name));
+    }
+    Bank& bank = found->second;
+
+    // recorded and replayed sessions have to draw the same questions whatever was seen before
+    const bool persistent = !Input::getInstance().isReproducible();
+    Pool& pool = persistent ? bank.pool : bank.sessionPool;
+    if (pool.order.empty()) {
+        // unseen questions first, so the pool starts where the previous sessions left off
+        pool.order.reserve(bank.questionCount);
+        for (uint32_t i = bank.firstQuestion; i < bank.firstQuestion + bank.questionCount; ++i) {
+            if (!persistent || !isSeen(i)) pool.order.push_back(i);
+        }
+        pool.unseen = static_cast<uint32_t>(pool.order.size());
+        for (uint32_t i = bank.firstQuestion; i < bank.firstQuestion + bank.questionCount; ++i) {
+            if (persistent && isSeen(i)) pool.order.push_back(i);
+        }
+    }
+
+    const uint32_t wanted = static_cast<uint32_t>(clamp(count, 0, static_cast<int>(bank.questionCount)));
+    if (pool.unseen < wanted) {
+        // not enough left: every question of the bank is fair game again
+        if (persistent) {
+            for (uint32_t index : pool.order) setSeen(index, false);
+        }
+        pool.unseen = bank.questionCount;
+    }
+
+    // partial Fisher-Yates: move a random unseen question to the end of the unseen range and shrink it
+    vector<uint32_t> drawn;
+    drawn.reserve(wanted);
+    for (uint32_t i = 0; i < wanted; ++i) {
+        uniform_int_distribution<uint32_t> pick(0, pool.unseen - 1);
+        swap(pool.order[pick(random)], pool.order[pool.unseen - 1]);
+        const uint32_t index = pool.order[--pool.unseen];
+        if (persistent) setSeen(index, true);
+        drawn.push_back(index);
+    }
+
+    if (persistent && wanted > 0) saveSeen();
+    return drawn;
+}
+
+void QuestionStore::setSeen(uint32_t index, bool value) {
+    const uint8_t bit = static_cast<uint8_t>(1u << (index % 8));
+    seen[index / 8] = value ? seen[index / 8] | bit : seen[index / 8] & ~bit;
+}
+
+// reads questions_seen.dat, a missing file or one written for other banks starts with nothing seen
+void QuestionStore::loadSeen() {
+    seen.assign((questionCount + 7) / 8, 0);
+
+    ifstream seenFile(seenPath, ios::binary);
+    if (!seenFile.is_open()) return;
+    ResourceStats::getInstance().recordFileRead();
+
+    SeenHeader header;
+    if (!seenFile.read(reinterpret_cast<char*>(&header), sizeof(header))
+        || header.magic != seenMagic || header.contentHash != contentHash || header.questionCount != questionCount) {
+        return;
+    }
+    vector<uint8_t> bits(seen.size());
+    if (seenFile.read(reinterpret_cast<char*>(bits.data()), bits.size())) {
+        seen = move(bits);
+    }
+}
+
+// hands the write to the job system, chained after the previous one so the newest bits land last
+void QuestionStore::saveSeen() {
+    string contents(sizeof(SeenHeader) + seen.size(), '\0');
+    SeenHeader header{ seenMagic, contentHash, questionCount };
+    memcpy(&contents[0], &header, sizeof(header));
+    memcpy(&contents[sizeof(header)], seen.data(), seen.size());
+
+    pendingWrite = JobSystem::getInstance().schedule([contents] {
+        ofstream seenFile(seenPath, ios::binary | ios::trunc);
+        ResourceStats::getInstance().recordFileWrite();
+        if (seenFile.is_open()) {
+            seenFile.write(contents.data(), contents.size());
+        }
+    }, { pendingWrite });
+}
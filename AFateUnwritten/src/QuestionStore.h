@@ -0,0 +1,76 @@
+#ifndef QUESTION_STORE_H
+#define QUESTION_STORE_H
+
+// Standard Library Includes
+#include <cstdint>
+#include <random>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// project includes
+#include "QuestionHandler.h"
+#include "JobSystem.h"
+#include "MappedFile.h"
+#include "QuestionFormat.h"
+
+// handles: the quiz banks, compiled from resources/narrative/*.quiz into questions.bin and mapped at first use
+// a bank can hold any number of questions: only the ones handed to a QuestionHandler are turned into strings
+// drawn questions are remembered in a seen-bitset (questions_seen.dat) so later sessions don't repeat them
+// until the bank has run out. recorded, replayed and scripted sessions draw from a fresh in-memory state
+// instead, so they play back the same questions for the same seed
+class QuestionStore {
+public:
+    static QuestionStore& getInstance();                              // singleton pattern: the banks are mapped once
+
+    // every question of a bank in script order, throws runtime_error if the bank isn't compiled in
+    std::vector<QuestionHandler::Question> getBank(std::string_view name) const;
+
+    // count questions of a bank the player hasn't seen yet (all of them if the bank is smaller), in random order
+    // O(count): a partial Fisher-Yates over the bank's index array, whose front holds the unseen questions
+    std::vector<QuestionHandler::Question> drawUnseen(std::string_view name, int count, std::mt19937& random);
+    std::vector<std::uint32_t> drawUnseenIndices(std::string_view name, int count, std::mt19937& random); // the same draw, as question indices
+
+    // questions by index (what drawUnseenIndices returned, e.g. kept in a save), throws runtime_error for an unknown index
+    std::vector<QuestionHandler::Question> getQuestions(const std::vector<std::uint32_t>& indices) const;
+
+    QuestionStore(const QuestionStore&) = delete;
+    QuestionStore& operator=(const QuestionStore&) = delete;
+
+private:
+    // constructor: maps and checks questions.bin (throws runtime_error if it is missing or from another version),
+    // then reads the seen-bitset if it belongs to these banks
+    QuestionStore();
+
+    // draw order of one bank: questions [0, unseen) of order haven't been drawn yet (built on the first draw)
+    struct Pool {
+        std::vector<std::uint32_t> order;                             // global question indices of the bank
+        std::uint32_t unseen = 0;
+    };
+
+    struct Bank {
+        std::uint32_t firstQuestion;
+        std::uint32_t questionCount;
+        Pool pool;                                                    // drawn against the seen-bitset
+        Pool sessionPool;                                             // drawn against nothing (reproducible runs)
+    };
+
+    MappedFile file;
+    std::uint32_t contentHash = 0;                                    // ties the seen-bitset to these banks
+    std::uint32_t questionCount = 0;
+    std::unordered_map<std::string_view, Bank> banks;
+    const QuestionFormat::QuestionRecord* questionRecords = nullptr;  // read in place, checked on use
+    const QuestionFormat::StringRef* optionRecords = nullptr;
+    std::uint32_t optionCount = 0;
+    std::string_view strings;                                         // the string table
+    std::vector<std::uint8_t> seen;                                   // one bit per question, persisted
+    JobSystem::JobHandle pendingWrite;                                // last seen-bitset write (later writes are chained after it)
+
+    QuestionHandler::Question makeQuestion(std::uint32_t index) const; // copies one question out of the mapping
+    bool isSeen(std::uint32_t index) const { return (seen[index / 8] >> (index % 8)) & 1; }
+    void setSeen(std::uint32_t index, bool value);
+    void loadSeen();
+    void saveSeen();                                                  // writes the seen-bitset on the job system
+};
+
+#endif
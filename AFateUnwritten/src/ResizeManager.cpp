@@ -6,8 +6,12 @@ using namespace sf;
 const Vector2f ResizeManager::BASE_RESOLUTION(1408.f, 728.f);
 
 // figures out how much everything should be scaled to fit the current window size
-Vector2f ResizeManager::getScale(const RenderWindow& window) {
-    Vector2u size = window.getSize();                    // grab the actual pixel size of the window
+Vector2f ResizeManager::getScale(const RenderTarget& window) {
+    return getScale(window.getSize());                   // grab the actual pixel size of the window
+}
+
+// scale factors for a window of the given pixel size
+Vector2f ResizeManager::getScale(Vector2u size) {
     return {
         static_cast<float>(size.x) / BASE_RESOLUTION.x,  // calculate horizontal scale factor
         static_cast<float>(size.y) / BASE_RESOLUTION.y   // calculate vertical scale factor
@@ -7,7 +7,8 @@
 class ResizeManager {
 public:
     static const sf::Vector2f BASE_RESOLUTION;                          // the default game resolution everything is designed around
-    static sf::Vector2f getScale(const sf::RenderWindow& window);       // calculates how much to scale things to fit the current window
+    static sf::Vector2f getScale(const sf::RenderTarget& window);       // calculates how much to scale things to fit the current window
+    static sf::Vector2f getScale(sf::Vector2u size);                    // same for a window size (layouts computed ahead of time)
     static sf::Vector2f scalePosition(sf::Vector2f pos, sf::Vector2f scale); // scales a given position based on the window size
     static float scaleText(float baseSize, float scaleY);               // scales text size so it looks good no matter the resolution
 };
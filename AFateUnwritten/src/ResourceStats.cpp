@@ -0,0 +1,26 @@
+#include "ResourceStats.h"
+
+using namespace std;
+using namespace sf;
+
+// singleton: get the single instance of ResourceStats
+ResourceStats& ResourceStats::getInstance() {
+    static ResourceStats instance;
+    return instance;
+}
+
+// counts a texture upload and its size in video memory
+void ResourceStats::recordTextureUpload(Vector2u size) {
+    textureUploads++;
+    textureBytes += static_cast<uint64_t>(size.x) * size.y * 4;
+}
+
+// copies all counters
+ResourceStats::Snapshot ResourceStats::snapshot() const {
+    Snapshot current;
+    current.fileReads = fileReads;
+    current.fileWrites = fileWrites;
+    current.textureUploads = textureUploads;
+    current.textureBytes = textureBytes;
+    return current;
+}
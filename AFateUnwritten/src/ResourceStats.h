@@ -0,0 +1,44 @@
+#ifndef RESOURCE_STATS_H
+#define RESOURCE_STATS_H
+
+// Standard Library Includes
+#include <atomic>
+#include <cstdint>
+
+// SFML Includes
+#include <SFML/System/Vector2.hpp>
+
+// handles: running totals of file I/O and texture uploads, so benchmarks can see what a scene costs
+// the counters only ever grow, callers take a snapshot before and after the part they want to measure
+// note: updated from job system workers as well (image decoding, save writes), hence the atomics
+class ResourceStats {
+public:
+    static ResourceStats& getInstance();                  // singleton pattern: one set of counters for the game
+
+    // a copy of all counters at one point in time
+    struct Snapshot {
+        std::uint64_t fileReads = 0;                      // files opened for reading (images, fonts, sounds, music, saves)
+        std::uint64_t fileWrites = 0;                     // files written (saves)
+        std::uint64_t textureUploads = 0;                 // textures created from files or decoded images
+        std::uint64_t textureBytes = 0;                   // RGBA bytes of those textures
+    };
+
+    // -- recording --
+    void recordFileRead() { fileReads++; }
+    void recordFileWrite() { fileWrites++; }
+    void recordTextureUpload(sf::Vector2u size);          // counts a texture of the given size (4 bytes per pixel)
+
+    // -- queries --
+    Snapshot snapshot() const;                            // current value of every counter
+
+private:
+    // constructor: ensure singleton pattern
+    ResourceStats() {}
+
+    std::atomic<std::uint64_t> fileReads{ 0 };
+    std::atomic<std::uint64_t> fileWrites{ 0 };
+    std::atomic<std::uint64_t> textureUploads{ 0 };
+    std::atomic<std::uint64_t> textureBytes{ 0 };
+};
+
+#endif
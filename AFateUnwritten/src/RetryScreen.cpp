@@ -1,5 +1,6 @@
 ﻿#include "RetryScreen.h"
 #include "LoadResources.h"
+#include "Trace.h"
 #include "GameScore.h"
 #include "ResizeManager.h"
 
@@ -129,6 +130,7 @@ void RetryScreen::updateOptions() {
 
 // displays the retry screen and handles user interactions
 RetryResult RetryScreen::show() {
+    Trace::Scope trace("RetryScreen::show", "modal");
     resize();      // ensure screen elements are properly resized
     Event event;
     while (window.isOpen()) {
@@ -0,0 +1,278 @@
+#include "SaveService.h"
+#include "ResourceStats.h"
+#include "Trace.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+static const char* const savePath = "savegame.dat";
+static const char* const temporaryPath = "savegame.dat.tmp";
+static const char* const legacyPath = "savegame.txt";
+
+// savegame.dat: this header, then a payload of payloadSize bytes (little-endian, like the compiled resources):
+// a SaveRecord, then (since version 2) a flag and the scene state written by putScene
+struct SaveHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t payloadSize;
+    uint32_t crc;                               // CRC32 of the payload
+};
+static const uint32_t saveMagic = 0x56534641;   // "AFSV"
+static const uint32_t saveVersion = 2;          // bump when the payload changes (and keep reading the old layouts)
+
+struct SaveRecord {
+    int32_t scene;
+    int32_t lion;
+    int32_t scarecrow;
+    int32_t tinman;
+};
+
+// appends the bytes of a value to a payload
+template <typename T>
+static void put(string& payload, const T& value) {
+    payload.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// reads a payload front to back, every read fails once the bytes run out
+struct PayloadReader {
+    const char* data;
+    size_t size;
+    size_t offset = 0;
+
+    template <typename T>
+    bool get(T& value) {
+        if (size - offset < sizeof(T)) return false;
+        memcpy(&value, data + offset, sizeof(T));
+        offset += sizeof(T);
+        return true;
+    }
+    bool getFlag(bool& value) {
+        uint8_t byte;
+        if (!get(byte)) return false;
+        value = byte != 0;
+        return true;
+    }
+};
+
+static void putQuiz(string& payload, const SceneSnapshot::Quiz& quiz) {
+    put(payload, quiz.question);
+    put(payload, quiz.selected);
+    put(payload, quiz.score);
+    put(payload, static_cast<uint8_t>(quiz.complete));
+}
+
+static bool getQuiz(PayloadReader& reader, SceneSnapshot::Quiz& quiz) {
+    return reader.get(quiz.question) && reader.get(quiz.selected) && reader.get(quiz.score) && reader.getFlag(quiz.complete);
+}
+
+static void putScene(string& payload, const SceneSnapshot& scene) {
+    put(payload, scene.state);
+    put(payload, scene.dialogueIndex);
+    put(payload, scene.typing.chunk);
+    put(payload, scene.typing.typed);
+    put(payload, static_cast<uint8_t>(scene.typing.awaitingNextChunk));
+    put(payload, static_cast<uint8_t>(scene.typing.awaitingFinalConfirm));
+    put(payload, static_cast<uint8_t>(scene.typing.complete));
+    putQuiz(payload, scene.quiz);
+    putQuiz(payload, scene.riddles);
+    put(payload, scene.scores);
+    put(payload, scene.timerMillis);
+    put(payload, static_cast<uint8_t>(scene.showFailureBox));
+    put(payload, static_cast<uint32_t>(scene.backgroundKey.size()));
+    payload += scene.backgroundKey;
+    put(payload, static_cast<uint32_t>(scene.questionIds.size()));
+    for (uint32_t id : scene.questionIds) put(payload, id);
+}
+
+static bool getScene(PayloadReader& reader, SceneSnapshot& scene) {
+    uint32_t keyLength = 0, idCount = 0;
+    if (!(reader.get(scene.state) && reader.get(scene.dialogueIndex) && reader.get(scene.typing.chunk)
+        && reader.get(scene.typing.typed) && reader.getFlag(scene.typing.awaitingNextChunk)
+        && reader.getFlag(scene.typing.awaitingFinalConfirm) && reader.getFlag(scene.typing.complete)
+        && getQuiz(reader, scene.quiz) && getQuiz(reader, scene.riddles) && reader.get(scene.scores)
+        && reader.get(scene.timerMillis) && reader.getFlag(scene.showFailureBox) && reader.get(keyLength))
+        || keyLength > reader.size - reader.offset) {
+        return false;
+    }
+    scene.backgroundKey.assign(reader.data + reader.offset, keyLength);
+    reader.offset += keyLength;
+
+    if (!reader.get(idCount) || idCount > (reader.size - reader.offset) / sizeof(uint32_t)) return false;
+    scene.questionIds.resize(idCount);
+    for (uint32_t& id : scene.questionIds) reader.get(id);
+    return true;
+}
+
+// CRC32 (IEEE, reflected), bitwise: a save is a few bytes so a table isn't worth it
+static uint32_t crc32(const char* data, size_t size) {
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < size; ++i) {
+        crc ^= static_cast<unsigned char>(data[i]);
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+// singleton: get the single instance of SaveService
+SaveService& SaveService::getInstance() {
+    static SaveService instance;
+    return instance;
+}
+
+SaveService::SaveService() {
+    JobSystem::getInstance();  // created first so it outlives the service
+}
+
+SaveService::~SaveService() {
+    flush();
+}
+
+void SaveService::save(const Snapshot& snapshot) {
+    const uint32_t number = ++latestSave;
+    pendingWrite = JobSystem::getInstance().schedule([this, number, contents = serialize(snapshot)] {
+        if (number != latestSave.load()) return;  // a newer save is queued behind this one
+        Trace::Scope trace("save", "io", savePath);
+        ResourceStats::getInstance().recordFileWrite();
+        writeAtomically(contents);
+    }, { pendingWrite });
+}
+
+bool SaveService::load(Snapshot& snapshot) {
+    flush();  // make sure the latest save has hit the disk
+
+    // a temp file left behind is newer than savegame.dat: a crash after finishing it but before the rename leaves
+    // a whole one (the CRC tells), which is moved into place; a torn one is thrown away
+    string contents;
+    if (readFile(temporaryPath, contents)) {
+        Snapshot recovered;
+        if (deserialize(contents, recovered) && replaceSave()) {
+            snapshot = recovered;
+            return true;
+        }
+        remove(temporaryPath);
+    }
+    if (readFile(savePath, contents) && deserialize(contents, snapshot)) return true;
+    return loadLegacy(snapshot);
+}
+
+void SaveService::flush() {
+    JobSystem::getInstance().wait(pendingWrite);
+}
+
+string SaveService::serialize(const Snapshot& snapshot) {
+    string contents(sizeof(SaveHeader), '\0');
+    put(contents, SaveRecord{ snapshot.scene, snapshot.lion, snapshot.scarecrow, snapshot.tinman });
+    put(contents, static_cast<uint8_t>(snapshot.hasSceneState));
+    if (snapshot.hasSceneState) {
+        putScene(contents, snapshot.sceneState);
+    }
+
+    const uint32_t payloadSize = static_cast<uint32_t>(contents.size() - sizeof(SaveHeader));
+    SaveHeader header{ saveMagic, saveVersion, payloadSize, crc32(contents.data() + sizeof(SaveHeader), payloadSize) };
+    memcpy(&contents[0], &header, sizeof(header));
+    return contents;
+}
+
+// rejects anything that isn't a whole save of a known version (torn writes, other files, tampering)
+bool SaveService::deserialize(const string& contents, Snapshot& snapshot) {
+    SaveHeader header;
+    if (contents.size() < sizeof(header)) return false;
+    memcpy(&header, contents.data(), sizeof(header));
+    if (header.magic != saveMagic || header.version < 1 || header.version > saveVersion
+        || contents.size() != sizeof(header) + header.payloadSize
+        || crc32(contents.data() + sizeof(header), header.payloadSize) != header.crc) {
+        return false;
+    }
+
+    PayloadReader reader{ contents.data() + sizeof(header), header.payloadSize };
+    SaveRecord record;
+    Snapshot loaded;
+    if (!reader.get(record)) return false;
+    loaded.scene = record.scene;
+    loaded.lion = record.lion;
+    loaded.scarecrow = record.scarecrow;
+    loaded.tinman = record.tinman;
+    if (header.version >= 2 && !(reader.getFlag(loaded.hasSceneState)
+        && (!loaded.hasSceneState || getScene(reader, loaded.sceneState)))) {
+        return false;
+    }
+    if (reader.offset != reader.size) return false;
+    snapshot = loaded;
+    return true;
+}
+
+bool SaveService::readFile(const char* path, string& contents) {
+    ifstream file(path, ios::binary);
+    if (!file.is_open()) return false;
+    ResourceStats::getInstance().recordFileRead();
+    contents.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+    return true;
+}
+
+// the save only replaces savegame.dat once its bytes are on the disk, so either the old or the new save survives
+bool SaveService::writeAtomically(const string& contents) {
+#ifdef _WIN32
+    HANDLE file = CreateFileA(temporaryPath, GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    DWORD written = 0;
+    const bool complete = WriteFile(file, contents.data(), static_cast<DWORD>(contents.size()), &written, nullptr)
+        && written == contents.size() && FlushFileBuffers(file);
+    CloseHandle(file);
+    return complete && replaceSave();
+#else
+    int file = open(temporaryPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (file < 0) return false;
+    size_t written = 0;
+    while (written < contents.size()) {
+        ssize_t result = write(file, contents.data() + written, contents.size() - written);
+        if (result <= 0) break;
+        written += static_cast<size_t>(result);
+    }
+    const bool complete = written == contents.size() && fsync(file) == 0;
+    ::close(file);
+    return complete && replaceSave();
+#endif
+}
+
+// renames the finished temp file over savegame.dat
+bool SaveService::replaceSave() {
+#ifdef _WIN32
+    return MoveFileExA(temporaryPath, savePath, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    if (rename(temporaryPath, savePath) != 0) return false;
+
+    // the rename itself lives in the directory, flush that too
+    int directory = open(".", O_RDONLY);
+    if (directory >= 0) {
+        fsync(directory);
+        ::close(directory);
+    }
+    return true;
+#endif
+}
+
+// savegame.txt: scene, lion, scarecrow and tinman score, one per line
+bool SaveService::loadLegacy(Snapshot& snapshot) {
+    ifstream loadFile(legacyPath);
+    if (!loadFile.is_open()) return false;
+    ResourceStats::getInstance().recordFileRead();
+
+    Snapshot legacy;
+    if (!(loadFile >> legacy.scene >> legacy.lion >> legacy.scarecrow >> legacy.tinman)) return false;
+    snapshot = legacy;
+    return true;
+}
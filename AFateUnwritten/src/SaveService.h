@@ -0,0 +1,61 @@
+#ifndef SAVE_SERVICE_H
+#define SAVE_SERVICE_H
+
+// Standard Library Includes
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+// project includes
+#include "JobSystem.h"
+#include "SceneSnapshot.h"
+
+// handles: the player's progress on disk (savegame.dat), written in the background so a save never stalls a frame
+// a save is a small versioned binary snapshot with a CRC32. it is written to savegame.dat.tmp, flushed to the disk
+// and then renamed over savegame.dat, so a crash mid-write leaves the previous save intact
+// (a temp file finished before the crash holds the newer save, the next load moves it into place)
+class SaveService {
+public:
+    static SaveService& getInstance();              // singleton pattern: one writer for the save file
+
+    // everything a save restores, scene is Game::Scene as an int
+    struct Snapshot {
+        std::int32_t scene = 0;
+        std::int32_t lion = 0;
+        std::int32_t scarecrow = 0;
+        std::int32_t tinman = 0;
+        bool hasSceneState = false;                 // false for saves that only know the chapter (start it over)
+        SceneSnapshot sceneState;                   // where in the chapter the player was
+    };
+
+    // serializes the snapshot and queues the write, returns right away
+    // a write still waiting when a newer save comes in is skipped, only the newest snapshot reaches the disk
+    void save(const Snapshot& snapshot);
+
+    // waits for queued writes, then reads the save back. false when there is no save or it doesn't check out
+    // (a savegame.txt from before the binary format is still read, the next save replaces it)
+    bool load(Snapshot& snapshot);
+
+    void flush();                                   // blocks until every queued write has finished
+
+    ~SaveService();                                 // finishes the last write before the service goes away
+
+    SaveService(const SaveService&) = delete;
+    SaveService& operator=(const SaveService&) = delete;
+
+private:
+    // constructor: ensure singleton pattern
+    SaveService();
+
+    JobSystem::JobHandle pendingWrite;              // last queued write (later writes are chained after it)
+    std::atomic<std::uint32_t> latestSave{ 0 };     // number of the newest save, older queued writes skip themselves
+
+    static std::string serialize(const Snapshot& snapshot);
+    static bool deserialize(const std::string& contents, Snapshot& snapshot);
+    static bool readFile(const char* path, std::string& contents);
+    static bool writeAtomically(const std::string& contents); // temp file, flush to disk, rename over the save
+    static bool replaceSave();                      // renames the temp file over the save (and flushes the rename)
+    static bool loadLegacy(Snapshot& snapshot);     // the old text savegame.txt
+};
+
+#endif
@@ -0,0 +1,42 @@
+#ifndef SCENE_SNAPSHOT_H
+#define SCENE_SNAPSHOT_H
+
+// Standard Library Includes
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// handles: where a chapter scene is in its state machine, so a save can put the player back on the same frame
+// scenes fill it in (getSnapshot) and take it back (restore) after a reset, SaveService stores it with the progress
+// fields a scene doesn't have keep their defaults
+struct SceneSnapshot {
+    // the typewriter inside the current dialogue line
+    struct Typing {
+        std::int32_t chunk = 0;                 // text box page of the line
+        std::uint32_t typed = 0;                // characters of that page already on screen
+        bool awaitingNextChunk = false;
+        bool awaitingFinalConfirm = false;
+        bool complete = false;
+    };
+
+    // a QuestionHandler part way through its questions
+    struct Quiz {
+        std::int32_t question = 0;              // current question
+        std::int32_t selected = -1;             // highlighted answer (-1 if none yet)
+        std::int32_t score = 0;
+        bool complete = false;
+    };
+
+    std::int32_t state = 0;                     // the scene's CurrentState
+    std::uint32_t dialogueIndex = 0;            // line of the narrative sequence the state is reading
+    Typing typing;
+    Quiz quiz;
+    Quiz riddles;                               // Tinman's second handler
+    std::int32_t scores[2] = { 0, 0 };          // the scene's own score counters (finalScore, quizScore/riddleScore)
+    std::int32_t timerMillis = -1;              // time spent on the riddles, -1 while the timer isn't running
+    bool showFailureBox = false;
+    std::string backgroundKey;                  // trigger phrase of the background on screen (empty: the default)
+    std::vector<std::uint32_t> questionIds;     // drawn questions (QuestionStore indices) when the scene draws them
+};
+
+#endif
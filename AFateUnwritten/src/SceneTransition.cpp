@@ -0,0 +1,106 @@
+#include "SceneTransition.h"
+#include "FrameProfiler.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+using namespace std;
+using namespace sf;
+
+// the overlay fades in (fade out of the scene) or away (fade in, crossfade) with an eased curve
+// textured: the overlay is the captured frame, otherwise its vertex colour (black)
+static const char* overlayShaderSource = R"(
+uniform sampler2D texture;
+uniform float progress;
+uniform float fadingIn;
+uniform float textured;
+
+void main() {
+    vec4 colour = gl_Color;
+    if (textured > 0.5) colour *= texture2D(texture, gl_TexCoord[0].xy);
+    float eased = progress * progress * (3.0 - 2.0 * progress);
+    float alpha = mix(eased, 1.0 - eased, fadingIn);
+    gl_FragColor = vec4(colour.rgb, colour.a * alpha);
+}
+)";
+
+// one shader for every transition, compiled on the first fade (null without shader support)
+static Shader* getOverlayShader() {
+    if (!Shader::isAvailable()) return nullptr;
+
+    static Shader shader;
+    static bool loaded = false;
+    if (!loaded) {
+        if (!shader.loadFromMemory(overlayShaderSource, Shader::Fragment)) {
+            throw runtime_error("Error compiling the transition shader");
+        }
+        shader.setUniform("texture", Shader::CurrentTexture);
+        loaded = true;
+    }
+    return &shader;
+}
+
+void SceneTransition::add(Kind kind, float duration, function<void()> onEnd) {
+    if (steps.empty()) elapsed = 0.0f;
+    steps.push_back({ kind, duration, move(onEnd) });
+}
+
+float SceneTransition::getProgress() const {
+    if (steps.empty() || steps.front().duration <= 0.0f) return 1.0f;
+    return min(elapsed / steps.front().duration, 1.0f);
+}
+
+// a frame ends at most one step: the callback may have switched scenes and the next step starts from its first frame
+void SceneTransition::update(float deltaTime) {
+    if (steps.empty()) return;
+    elapsed += deltaTime;
+    if (elapsed < steps.front().duration) return;
+
+    function<void()> onEnd = move(steps.front().onEnd);
+    steps.pop_front();
+    elapsed = 0.0f;
+    if (onEnd) onEnd();  // may queue more steps
+}
+
+void SceneTransition::skip() {
+    if (!steps.empty()) elapsed = steps.front().duration;
+}
+
+// one quad over the whole view, its alpha follows the step (in the shader, or on the vertices without one)
+void SceneTransition::drawOverlay(RenderTarget& target) const {
+    if (steps.empty() || steps.front().kind == Kind::TitleCard) return;
+    const bool crossfade = steps.front().kind == Kind::Crossfade;
+    if (crossfade && outgoing.getSize().x == 0) return;  // nothing was captured (nothing is drawn either)
+
+    const float progress = getProgress();
+    const bool fadingIn = steps.front().kind != Kind::FadeOut;
+
+    const View& view = target.getView();
+    const Vector2f topLeft = view.getCenter() - view.getSize() / 2.f;
+    const Vector2f size = view.getSize();
+    const Vector2f frame(outgoing.getSize());
+
+    VertexArray quad(TriangleStrip, 4);
+    quad[0] = Vertex(topLeft, Vector2f(0.f, 0.f));
+    quad[1] = Vertex(topLeft + Vector2f(size.x, 0.f), Vector2f(frame.x, 0.f));
+    quad[2] = Vertex(topLeft + Vector2f(0.f, size.y), Vector2f(0.f, frame.y));
+    quad[3] = Vertex(topLeft + size, frame);
+
+    RenderStates states;
+    if (crossfade) states.texture = &outgoing;
+    Color colour = crossfade ? Color::White : Color::Black;
+    if (Shader* shader = getOverlayShader()) {
+        shader->setUniform("progress", progress);
+        shader->setUniform("fadingIn", fadingIn ? 1.0f : 0.0f);
+        shader->setUniform("textured", crossfade ? 1.0f : 0.0f);
+        states.shader = shader;
+    }
+    else {
+        float eased = progress * progress * (3.0f - 2.0f * progress);
+        colour.a = static_cast<Uint8>(255.0f * (fadingIn ? 1.0f - eased : eased));
+    }
+    for (size_t i = 0; i < quad.getVertexCount(); ++i) {
+        quad[i].color = colour;
+    }
+    FrameProfiler::draw(target, quad, states);
+}
@@ -0,0 +1,46 @@
+#ifndef SCENE_TRANSITION_H
+#define SCENE_TRANSITION_H
+
+// SFML & Standard Library Includes
+#include <SFML/Graphics.hpp>
+#include <deque>
+#include <functional>
+
+// handles: the fades between scenes, played inside the main loop instead of blocking it
+// a transition is a queue of timed steps (fade out, title card, fade in, crossfade), advanced by game time,
+// Game draws the scenes as usual and the running step's overlay on top: one extra draw call, drawn by a shader
+// a step can run a callback when it ends, that is where Game switches scenes (under a black screen or a crossfade)
+class SceneTransition {
+public:
+    enum class Kind {
+        FadeOut,        // the scene goes to black (the outgoing scene is drawn, not updated)
+        TitleCard,      // the chapter title covers the screen (Game draws it)
+        FadeIn,         // the scene comes up from black
+        Crossfade       // the captured outgoing frame dissolves into the scene
+    };
+
+    // -- building --
+    void add(Kind kind, float duration, std::function<void()> onEnd = nullptr); // queues a step after the others
+    sf::Texture& getOutgoingFrame() { return outgoing; } // what a crossfade dissolves, captured by Game before it switches
+
+    // -- per frame --
+    bool isActive() const { return !steps.empty(); }
+    Kind getKind() const { return steps.front().kind; }   // of the running step (only while active)
+    float getElapsed() const { return elapsed; }          // game seconds into the running step
+    float getProgress() const;                            // 0 to 1 through the running step
+    void update(float deltaTime);                         // advances by game time, ended steps run their callback
+    void skip();                                          // ends the running step with the next update
+    void drawOverlay(sf::RenderTarget& target) const;     // draws the running step over what target holds (not the title card)
+
+private:
+    struct Step {
+        Kind kind;
+        float duration;
+        std::function<void()> onEnd;
+    };
+    std::deque<Step> steps;            // the running step is at the front
+    float elapsed = 0.0f;
+    sf::Texture outgoing;              // last frame of the scene being replaced (empty when nothing is drawn)
+};
+
+#endif
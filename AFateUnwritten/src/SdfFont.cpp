@@ -0,0 +1,237 @@
+#include "SdfFont.h"
+#include "LoadResources.h"
+#include "JobSystem.h"
+#include "MemoryTracker.h"
+#include "ResourceStats.h"
+#include "Trace.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace sf;
+
+// the characters every atlas holds: ASCII, Latin-1 and the typographic quotes and dashes the story uses
+static vector<Uint32> atlasCharacters() {
+    vector<Uint32> characters;
+    for (Uint32 c = 0x20; c <= 0x7E; ++c) characters.push_back(c);
+    for (Uint32 c = 0xA0; c <= 0xFF; ++c) characters.push_back(c);
+    for (Uint32 c : { 0x2013u, 0x2014u, 0x2018u, 0x2019u, 0x201Cu, 0x201Du, 0x2026u }) characters.push_back(c);
+    return characters;
+}
+
+static const unsigned int atlasWidth = 1024; // fields are packed in rows (shelves) this wide
+static const int fieldGap = 1;               // empty pixels between fields, smooth sampling mustn't pick up a neighbour
+static const float unreached = 1e20f;        // squared distance of a pixel with no feature in reach yet
+
+// squared distance transform of one row or column (Felzenszwalb & Huttenlocher): d[q] = min over p of (q - p)^2 + f[p]
+// v and z are scratch space for the lower envelope of the parabolas (n and n + 1 entries)
+static void distanceTransform1D(const float* f, float* d, int n, int* v, float* z) {
+    int k = 0;
+    v[0] = 0;
+    z[0] = -unreached;
+    z[1] = unreached;
+    for (int q = 1; q < n; ++q) {
+        float s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.0f * q - 2.0f * v[k]);
+        while (s <= z[k]) {
+            --k;
+            s = ((f[q] + q * q) - (f[v[k]] + v[k] * v[k])) / (2.0f * q - 2.0f * v[k]);
+        }
+        ++k;
+        v[k] = q;
+        z[k] = s;
+        z[k + 1] = unreached;
+    }
+    k = 0;
+    for (int q = 0; q < n; ++q) {
+        while (z[k + 1] < q) ++k;
+        d[q] = (q - v[k]) * (q - v[k]) + f[v[k]];
+    }
+}
+
+// squared distance from every pixel to the nearest feature pixel (0 in grid), columns first, then rows
+static void distanceTransform2D(vector<float>& grid, int width, int height) {
+    const int n = max(width, height);
+    vector<float> f(n), d(n), z(n + 1);
+    vector<int> v(n);
+    for (int x = 0; x < width; ++x) {
+        for (int y = 0; y < height; ++y) f[y] = grid[y * width + x];
+        distanceTransform1D(f.data(), d.data(), height, v.data(), z.data());
+        for (int y = 0; y < height; ++y) grid[y * width + x] = d[y];
+    }
+    for (int y = 0; y < height; ++y) {
+        distanceTransform1D(&grid[y * width], d.data(), width, v.data(), z.data());
+        copy(d.begin(), d.begin() + width, grid.begin() + y * width);
+    }
+}
+
+// distance field of one rasterized glyph (rect on the glyph page), spread pixels larger on every side
+// 0.5 is the outline, 1 is spread pixels inside, 0 spread pixels outside
+static vector<Uint8> buildField(const Image& page, const IntRect& rect) {
+    const int spread = SdfFont::spread;
+    const int width = rect.width + 2 * spread;
+    const int height = rect.height + 2 * spread;
+    const Uint8* pixels = page.getPixelsPtr();
+    const unsigned int pageWidth = page.getSize().x;
+
+    vector<bool> ink(width * height, false);
+    for (int y = 0; y < rect.height; ++y) {
+        for (int x = 0; x < rect.width; ++x) {
+            Uint8 coverage = pixels[4 * ((rect.top + y) * pageWidth + rect.left + x) + 3];  // glyph pages are white, alpha is coverage
+            ink[(y + spread) * width + x + spread] = coverage >= 128;
+        }
+    }
+
+    vector<float> toInk(width * height), toEmpty(width * height);
+    for (size_t i = 0; i < ink.size(); ++i) {
+        toInk[i] = ink[i] ? 0.0f : unreached;
+        toEmpty[i] = ink[i] ? unreached : 0.0f;
+    }
+    distanceTransform2D(toInk, width, height);
+    distanceTransform2D(toEmpty, width, height);
+
+    vector<Uint8> field(width * height);
+    for (size_t i = 0; i < field.size(); ++i) {
+        // the outline runs between an ink pixel and its empty neighbour, half a pixel from both
+        float distance = ink[i] ? 0.5f - sqrt(toEmpty[i]) : sqrt(toInk[i]) - 0.5f;
+        float value = clamp(0.5f - distance / (2.0f * spread), 0.0f, 1.0f);
+        field[i] = static_cast<Uint8>(value * 255.0f + 0.5f);
+    }
+    return field;
+}
+
+// the fonts live until the game exits, get() builds each one once
+const SdfFont& SdfFont::get(const string& path) {
+    MemoryTracker::getInstance();      // created first so they outlive the fonts
+    JobSystem::getInstance();
+    static unordered_map<string, unique_ptr<SdfFont>> fonts;
+    unique_ptr<SdfFont>& font = fonts[path];
+    if (!font) font.reset(new SdfFont(path));
+    return *font;
+}
+
+// rasterizes the characters at referenceSize, turns them into fields on the job system and packs them into one texture
+SdfFont::SdfFont(const string& path) {
+    Trace::Scope trace("SdfFont::build", "load", path);
+    resourceLoader(font, path);
+    MemoryTracker::getInstance().release(&font);  // shared by every scene, so not counted for whoever asked first
+    MemoryTracker::getInstance().track(&font, MemoryTracker::Type::Font, path, 0, "Fonts");
+    lineSpacing = font.getLineSpacing(referenceSize);
+
+    // rasterizing goes through the font's glyph page (a texture), so it stays on the main thread
+    const vector<Uint32> characters = atlasCharacters();
+    vector<sf::Glyph> rasterized;
+    rasterized.reserve(characters.size());
+    for (Uint32 c : characters) {
+        rasterized.push_back(font.getGlyph(c, referenceSize, false));
+    }
+    const Image page = font.getTexture(referenceSize).copyToImage();
+    MemoryTracker::getInstance().trackFontPage(font, referenceSize);
+
+    JobSystem& jobs = JobSystem::getInstance();
+    vector<vector<Uint8>> fields(characters.size());
+    vector<JobSystem::JobHandle> fieldJobs;
+    for (size_t i = 0; i < characters.size(); ++i) {
+        const IntRect& rect = rasterized[i].textureRect;
+        if (rect.width <= 0 || rect.height <= 0) continue;  // blanks have no ink
+        fieldJobs.push_back(jobs.schedule([&fields, &page, &rect, i] {
+            fields[i] = buildField(page, rect);
+        }));
+    }
+    jobs.waitAll(fieldJobs);
+
+    // shelf packing, tallest first so the rows waste little height
+    vector<size_t> order(characters.size());
+    for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+    sort(order.begin(), order.end(), [&rasterized](size_t a, size_t b) {
+        return rasterized[a].textureRect.height > rasterized[b].textureRect.height;
+    });
+
+    int x = fieldGap, y = fieldGap, shelfHeight = 0;
+    for (size_t i : order) {
+        const IntRect& rect = rasterized[i].textureRect;
+        Glyph& glyph = glyphs[characters[i]];
+        glyph.advance = rasterized[i].advance;
+        glyph.bounds = rasterized[i].bounds;
+        if (fields[i].empty()) continue;
+
+        const int width = rect.width + 2 * spread;
+        const int height = rect.height + 2 * spread;
+        if (x + width + fieldGap > static_cast<int>(atlasWidth)) {
+            x = fieldGap;
+            y += shelfHeight + fieldGap;
+            shelfHeight = 0;
+        }
+        glyph.textureRect = IntRect(x, y, width, height);
+        x += width + fieldGap;
+        shelfHeight = max(shelfHeight, height);
+    }
+
+    Image pixels;
+    pixels.create(atlasWidth, y + shelfHeight + fieldGap, Color(255, 255, 255, 0));
+    for (size_t i = 0; i < characters.size(); ++i) {
+        const IntRect& rect = glyphs[characters[i]].textureRect;
+        for (int row = 0; row < rect.height; ++row) {
+            for (int column = 0; column < rect.width; ++column) {
+                pixels.setPixel(rect.left + column, rect.top + row, Color(255, 255, 255, fields[i][row * rect.width + column]));
+            }
+        }
+    }
+
+    if (!atlas.loadFromImage(pixels)) {
+        throw runtime_error("Error uploading the glyph atlas of: " + path);
+    }
+    atlas.setSmooth(true);  // the shader reads the distance between texels
+    ResourceStats::getInstance().recordTextureUpload(atlas.getSize());
+    MemoryTracker::getInstance().track(&atlas, MemoryTracker::Type::Texture, path + " (glyph atlas)",
+        static_cast<uint64_t>(atlas.getSize().x) * atlas.getSize().y * 4, "Fonts");
+}
+
+SdfFont::~SdfFont() {
+    MemoryTracker::getInstance().release(&atlas);
+    MemoryTracker::getInstance().release(&font);
+}
+
+const SdfFont::Glyph& SdfFont::getGlyph(Uint32 codePoint) const {
+    auto it = glyphs.find(codePoint);
+    if (it == glyphs.end()) it = glyphs.find('?');
+    return it->second;
+}
+
+float SdfFont::getKerning(Uint32 first, Uint32 second) const {
+    return font.getKerning(first, second, referenceSize);
+}
+
+// the outline is where the distance crosses 0.5 - weight, smoothed over about a screen pixel whatever the size
+static const char* textShaderSource = R"(
+uniform sampler2D texture;
+uniform float weight;
+
+void main() {
+    float distance = texture2D(texture, gl_TexCoord[0].xy).a;
+    float edge = 0.5 - weight;
+    float smoothing = max(fwidth(distance) * 0.75, 0.001);
+    float alpha = smoothstep(edge - smoothing, edge + smoothing, distance);
+    gl_FragColor = vec4(gl_Color.rgb, gl_Color.a * alpha);
+}
+)";
+
+// one shader for every font, compiled on the first draw
+const Shader* SdfFont::getShader(float weight) {
+    if (!Shader::isAvailable()) return nullptr;
+
+    static Shader shader;
+    static bool loaded = false;
+    if (!loaded) {
+        if (!shader.loadFromMemory(textShaderSource, Shader::Fragment)) {
+            throw runtime_error("Error compiling the text shader");
+        }
+        shader.setUniform("texture", Shader::CurrentTexture);
+        loaded = true;
+    }
+    shader.setUniform("weight", weight);
+    return &shader;
+}
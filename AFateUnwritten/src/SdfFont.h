@@ -0,0 +1,52 @@
+#ifndef SDF_FONT_H
+#define SDF_FONT_H
+
+// SFML & Standard Library Includes
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <unordered_map>
+
+// handles: one signed distance field glyph atlas per font file, shared by every SdfText drawn in that font
+// an sf::Text rasterizes a new glyph page for every character size it is drawn at (ResizeManager::scaleText gives a
+// new size per window size, title cards are 100pt), here the glyphs are rasterized once at referenceSize and turned
+// into distance fields, and the text shader cuts a sharp edge out of them at any size
+// the fields are computed on the JobSystem (one job per glyph), the atlas is uploaded once on the main thread
+// note: main thread only (get() loads the font and uploads the atlas)
+class SdfFont {
+public:
+    static const SdfFont& get(const std::string& path);  // the font's atlas, built the first time it is asked for
+
+    static constexpr const char* uiFontPath = "resources/fonts/INFROMAN.ttf"; // buttons, timer and name tags
+    static constexpr unsigned int referenceSize = 48;    // character size the glyphs are rasterized at
+    static constexpr int spread = 6;                     // reference pixels the field reaches out from an edge (each side)
+
+    // one glyph, in reference pixels
+    struct Glyph {
+        float advance = 0.0f;            // pen movement to the next glyph
+        sf::FloatRect bounds;            // ink box relative to the pen on the baseline (like sf::Glyph::bounds)
+        sf::IntRect textureRect;         // field in the atlas: the ink box plus spread on every side
+    };
+
+    const Glyph& getGlyph(sf::Uint32 codePoint) const;   // characters missing from the atlas get '?'
+    float getKerning(sf::Uint32 first, sf::Uint32 second) const; // in reference pixels
+    float getLineSpacing() const { return lineSpacing; } // in reference pixels
+    const sf::Texture& getTexture() const { return atlas; }
+
+    // text shader with the edge moved out by weight (0 regular, more is bolder), null without shader support
+    // (the fields are then drawn as they are: readable, with soft edges)
+    static const sf::Shader* getShader(float weight);
+
+    SdfFont(const SdfFont&) = delete;
+    SdfFont& operator=(const SdfFont&) = delete;
+    ~SdfFont();                          // releases the atlas from the memory tracker
+
+private:
+    explicit SdfFont(const std::string& path);  // loads the font and builds the atlas
+
+    sf::Font font;                       // face for kerning and line spacing (its glyph pages stay at referenceSize)
+    sf::Texture atlas;                   // every field, alpha is the distance (0.5 on the edge, more inside)
+    std::unordered_map<sf::Uint32, Glyph> glyphs; // by code point
+    float lineSpacing = 0.0f;
+};
+
+#endif
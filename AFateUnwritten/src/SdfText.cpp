@@ -0,0 +1,138 @@
+#include "SdfText.h"
+
+#include <algorithm>
+
+using namespace std;
+using namespace sf;
+
+// constructor: text ready to draw in the given font and size
+SdfText::SdfText(const String& string, const SdfFont& font, unsigned int characterSize)
+    : string(string), font(&font), characterSize(characterSize), geometryNeedUpdate(true) {}
+
+void SdfText::setString(const String& string) {
+    if (this->string == string) return;
+    this->string = string;
+    geometryNeedUpdate = true;
+}
+
+void SdfText::setFont(const SdfFont& font) {
+    if (this->font == &font) return;
+    this->font = &font;
+    geometryNeedUpdate = true;
+}
+
+void SdfText::setCharacterSize(unsigned int size) {
+    if (characterSize == size) return;
+    characterSize = size;
+    geometryNeedUpdate = true;
+}
+
+// recolours the existing quads, no new layout needed
+void SdfText::setFillColor(const Color& color) {
+    if (fillColor == color) return;
+    fillColor = color;
+    if (!geometryNeedUpdate) {
+        for (size_t i = 0; i < vertices.getVertexCount(); ++i) {
+            vertices[i].color = fillColor;
+        }
+    }
+}
+
+// bold only moves the outline out in the shader, the layout stays the same
+void SdfText::setStyle(Uint32 style) {
+    this->style = style;
+}
+
+FloatRect SdfText::getLocalBounds() const {
+    ensureGeometryUpdate();
+    return bounds;
+}
+
+FloatRect SdfText::getGlobalBounds() const {
+    return getTransform().transformRect(getLocalBounds());
+}
+
+// draws every glyph in one call with the atlas and the text shader
+void SdfText::draw(RenderTarget& target, RenderStates states) const {
+    if (!font) return;
+    ensureGeometryUpdate();
+
+    states.transform *= getTransform();
+    states.texture = &font->getTexture();
+    // bold: one reference pixel thicker (the field changes by 1 / (2 * spread) per pixel)
+    states.shader = SdfFont::getShader((style & Text::Bold) ? 1.0f / (2 * SdfFont::spread) : 0.0f);
+    target.draw(vertices, states);
+}
+
+// pen starts at the top left with the baseline one character size down, like sf::Text
+void SdfText::ensureGeometryUpdate() const {
+    if (!geometryNeedUpdate || !font) return;
+    geometryNeedUpdate = false;
+
+    vertices.clear();
+    bounds = FloatRect();
+    if (string.isEmpty()) return;
+
+    const float scale = static_cast<float>(characterSize) / SdfFont::referenceSize;
+    const float whitespaceWidth = font->getGlyph(L' ').advance * scale;
+    const float lineSpacing = font->getLineSpacing() * scale;
+    float x = 0.0f;
+    float y = static_cast<float>(characterSize);
+
+    float minX = static_cast<float>(characterSize);
+    float minY = static_cast<float>(characterSize);
+    float maxX = 0.0f;
+    float maxY = 0.0f;
+    Uint32 previous = 0;
+
+    for (size_t i = 0; i < string.getSize(); ++i) {
+        Uint32 current = string[i];
+        if (current == L'\r') continue;  // sf::Text skips it too
+        x += font->getKerning(previous, current) * scale;
+        previous = current;
+
+        if (current == L' ' || current == L'\n' || current == L'\t') {
+            minX = min(minX, x);
+            minY = min(minY, y);
+            switch (current) {
+            case L' ':  x += whitespaceWidth; break;
+            case L'\t': x += whitespaceWidth * 4; break;
+            case L'\n': y += lineSpacing; x = 0; break;
+            }
+            maxX = max(maxX, x);
+            maxY = max(maxY, y);
+            continue;
+        }
+
+        const SdfFont::Glyph& glyph = font->getGlyph(current);
+        const IntRect& field = glyph.textureRect;
+        if (field.width > 0) {
+            // the field reaches spread pixels past the ink box on every side
+            float left = x + (glyph.bounds.left - SdfFont::spread) * scale;
+            float top = y + (glyph.bounds.top - SdfFont::spread) * scale;
+            float right = left + field.width * scale;
+            float bottom = top + field.height * scale;
+
+            float u1 = static_cast<float>(field.left);
+            float v1 = static_cast<float>(field.top);
+            float u2 = static_cast<float>(field.left + field.width);
+            float v2 = static_cast<float>(field.top + field.height);
+
+            vertices.append(Vertex(Vector2f(left, top), fillColor, Vector2f(u1, v1)));
+            vertices.append(Vertex(Vector2f(right, top), fillColor, Vector2f(u2, v1)));
+            vertices.append(Vertex(Vector2f(left, bottom), fillColor, Vector2f(u1, v2)));
+            vertices.append(Vertex(Vector2f(left, bottom), fillColor, Vector2f(u1, v2)));
+            vertices.append(Vertex(Vector2f(right, top), fillColor, Vector2f(u2, v1)));
+            vertices.append(Vertex(Vector2f(right, bottom), fillColor, Vector2f(u2, v2)));
+        }
+
+        minX = min(minX, x + glyph.bounds.left * scale);
+        maxX = max(maxX, x + (glyph.bounds.left + glyph.bounds.width) * scale);
+        minY = min(minY, y + glyph.bounds.top * scale);
+        maxY = max(maxY, y + (glyph.bounds.top + glyph.bounds.height) * scale);
+
+        x += glyph.advance * scale;
+    }
+
+    bounds = FloatRect(minX, minY, maxX - minX, maxY - minY);
+}
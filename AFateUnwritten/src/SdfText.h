@@ -0,0 +1,51 @@
+#ifndef SDF_TEXT_H
+#define SDF_TEXT_H
+
+// SFML & Standard Library Includes
+#include <SFML/Graphics.hpp>
+
+// project includes
+#include "SdfFont.h"
+
+// handles: a line (or lines) of text drawn from an SdfFont atlas, laid out like sf::Text (same origin, bounds and
+// line spacing) so it can stand in for one
+// changing the character size only rescales the quads: no glyph page is rasterized, whatever the size
+class SdfText : public sf::Drawable, public sf::Transformable {
+public:
+    // -- constructor --
+    SdfText() = default;
+    SdfText(const sf::String& string, const SdfFont& font, unsigned int characterSize = 30);
+
+    // -- appearance --
+    void setString(const sf::String& string);
+    void setFont(const SdfFont& font);
+    void setCharacterSize(unsigned int size);       // cheap: the glyphs are scaled, not rasterized again
+    void setFillColor(const sf::Color& color);
+    void setStyle(sf::Uint32 style);                // sf::Text::Regular or sf::Text::Bold (other styles are ignored)
+
+    const sf::String& getString() const { return string; }
+    const SdfFont* getFont() const { return font; }
+    unsigned int getCharacterSize() const { return characterSize; }
+    const sf::Color& getFillColor() const { return fillColor; }
+    sf::Uint32 getStyle() const { return style; }
+
+    // -- layout --
+    sf::FloatRect getLocalBounds() const;           // ink box of the text, before the transform
+    sf::FloatRect getGlobalBounds() const;          // ink box on screen
+
+private:
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+    void ensureGeometryUpdate() const;              // lays the quads out again after a change
+
+    sf::String string;
+    const SdfFont* font = nullptr;
+    unsigned int characterSize = 30;
+    sf::Color fillColor = sf::Color::White;
+    sf::Uint32 style = sf::Text::Regular;
+
+    mutable sf::VertexArray vertices{ sf::Triangles }; // two triangles per glyph
+    mutable sf::FloatRect bounds;
+    mutable bool geometryNeedUpdate = false;
+};
+
+#endif
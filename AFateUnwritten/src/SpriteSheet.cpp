@@ -0,0 +1,207 @@
+#include "SpriteSheet.h"
+#include "FrameProfiler.h"
+#include "MemoryTracker.h"
+#include "ResourceStats.h"
+#include "Trace.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <unordered_map>
+
+using namespace std;
+using namespace sf;
+
+static const unsigned int pageLimit = 4096;  // largest page side, even where the GPU allows more (smaller allocations)
+
+// the page holds four frames' palette indices per texel, channel picks this frame's, the colour is in its palette row
+static const char* paletteShaderSource = R"(
+uniform sampler2D texture;
+uniform sampler2D palette;
+uniform vec4 channel;
+uniform float paletteRow;
+
+void main() {
+    float index = dot(texture2D(texture, gl_TexCoord[0].xy), channel);
+    gl_FragColor = texture2D(palette, vec2((index * 255.0 + 0.5) / 256.0, paletteRow)) * gl_Color;
+}
+)";
+
+// one shader for every paletted sheet, compiled when the first one is built
+static Shader& getPaletteShader() {
+    static Shader shader;
+    static bool loaded = false;
+    if (!loaded) {
+        if (!shader.loadFromMemory(paletteShaderSource, Shader::Fragment)) {
+            throw runtime_error("Error compiling the palette shader");
+        }
+        shader.setUniform("texture", Shader::CurrentTexture);
+        loaded = true;
+    }
+    return shader;
+}
+
+// gives up as soon as a 257th colour shows up (photographic frames stay RGBA)
+void SpriteSheet::indexColours(Frame& frame) {
+    const Vector2u size = frame.image.getSize();
+    const Uint8* pixels = frame.image.getPixelsPtr();
+    const size_t count = static_cast<size_t>(size.x) * size.y;
+
+    unordered_map<Uint32, Uint8> lookup;
+    vector<Uint8> indices(count);
+    vector<Color> palette;
+    Uint32 lastColour = 0;
+    Uint8 lastIndex = 0;
+    for (size_t i = 0; i < count; ++i) {
+        Uint32 colour;
+        memcpy(&colour, pixels + 4 * i, 4);
+        if (i > 0 && colour == lastColour) {  // runs of one colour are the common case
+            indices[i] = lastIndex;
+            continue;
+        }
+        auto it = lookup.find(colour);
+        if (it == lookup.end()) {
+            if (palette.size() == 256) return;  // not paletted, indices stay empty
+            it = lookup.emplace(colour, static_cast<Uint8>(palette.size())).first;
+            palette.push_back(Color(pixels[4 * i], pixels[4 * i + 1], pixels[4 * i + 2], pixels[4 * i + 3]));
+        }
+        indices[i] = lastIndex = it->second;
+        lastColour = colour;
+    }
+    frame.indices = move(indices);
+    frame.palette = move(palette);
+}
+
+SpriteSheet::~SpriteSheet() {
+    release();
+}
+
+void SpriteSheet::release() {
+    for (const Texture& page : pages) {
+        MemoryTracker::getInstance().release(&page);
+    }
+    MemoryTracker::getInstance().release(&palettes);
+    pages.clear();
+    slots.clear();
+    palettes = Texture();
+    paletted = false;
+}
+
+// tiles are laid out in a grid as square as the page limit allows, a page holds as many as fit
+void SpriteSheet::build(const vector<Frame>& frames, const string& name, const string& memoryOwner) {
+    Trace::Scope trace("SpriteSheet::build", "load", name);
+    release();
+    if (frames.empty()) return;
+
+    frameSize = frames[0].image.getSize();
+    paletted = Shader::isAvailable();
+    for (const Frame& frame : frames) {
+        if (frame.image.getSize() != frameSize) {
+            throw runtime_error("Error packing " + name + ": frames differ in size");
+        }
+        paletted = paletted && !frame.indices.empty();
+    }
+
+    const unsigned int maxSide = min(Texture::getMaximumSize(), pageLimit);
+    if (frameSize.x == 0 || frameSize.y == 0 || frameSize.x > maxSide || frameSize.y > maxSide) {
+        throw runtime_error("Error packing " + name + ": frames don't fit a texture");
+    }
+    const size_t framesPerTile = paletted ? 4 : 1;
+    const size_t tileCount = (frames.size() + framesPerTile - 1) / framesPerTile;
+    const size_t maxColumns = maxSide / frameSize.x;
+    const size_t maxRows = maxSide / frameSize.y;
+    const size_t tilesPerPage = maxColumns * maxRows;
+
+    pages.resize((tileCount + tilesPerPage - 1) / tilesPerPage);
+    slots.resize(frames.size());
+    for (size_t page = 0; page < pages.size(); ++page) {
+        const size_t firstTile = page * tilesPerPage;
+        const size_t tiles = min(tilesPerPage, tileCount - firstTile);
+        size_t columns = static_cast<size_t>(ceil(sqrt(static_cast<double>(tiles) * frameSize.y / frameSize.x)));
+        columns = clamp<size_t>(columns, 1, maxColumns);
+        size_t rows = (tiles + columns - 1) / columns;
+        if (rows > maxRows) {
+            rows = maxRows;
+            columns = (tiles + rows - 1) / rows;
+        }
+
+        const Vector2u pageSize(static_cast<unsigned int>(columns * frameSize.x), static_cast<unsigned int>(rows * frameSize.y));
+        vector<Uint8> pixels(static_cast<size_t>(pageSize.x) * pageSize.y * 4, 0);
+        for (size_t tile = 0; tile < tiles; ++tile) {
+            const unsigned int left = static_cast<unsigned int>((tile % columns) * frameSize.x);
+            const unsigned int top = static_cast<unsigned int>((tile / columns) * frameSize.y);
+            for (size_t channel = 0; channel < framesPerTile; ++channel) {
+                const size_t index = (firstTile + tile) * framesPerTile + channel;
+                if (index >= frames.size()) break;
+                slots[index] = { page, IntRect(left, top, frameSize.x, frameSize.y), static_cast<int>(channel) };
+
+                const Frame& frame = frames[index];
+                for (unsigned int y = 0; y < frameSize.y; ++y) {
+                    Uint8* row = &pixels[(static_cast<size_t>(top + y) * pageSize.x + left) * 4];
+                    if (paletted) {
+                        const Uint8* source = &frame.indices[static_cast<size_t>(y) * frameSize.x];
+                        for (unsigned int x = 0; x < frameSize.x; ++x) row[x * 4 + channel] = source[x];
+                    }
+                    else {
+                        memcpy(row, frame.image.getPixelsPtr() + static_cast<size_t>(y) * frameSize.x * 4, frameSize.x * 4);
+                    }
+                }
+            }
+        }
+
+        if (!pages[page].create(pageSize.x, pageSize.y)) {
+            throw runtime_error("Error creating a sprite sheet page for: " + name);
+        }
+        pages[page].update(pixels.data());  // indices are looked up exactly, so no smoothing
+        ResourceStats::getInstance().recordTextureUpload(pageSize);
+        MemoryTracker::getInstance().track(&pages[page], MemoryTracker::Type::Texture, name + " (sheet page " + to_string(page) + ")",
+            static_cast<uint64_t>(pageSize.x) * pageSize.y * 4, memoryOwner);
+    }
+
+    if (paletted) {
+        const Vector2u paletteSize(256, static_cast<unsigned int>(frames.size()));
+        vector<Uint8> colours(static_cast<size_t>(paletteSize.x) * paletteSize.y * 4, 0);
+        for (size_t row = 0; row < frames.size(); ++row) {
+            const vector<Color>& palette = frames[row].palette;
+            for (size_t i = 0; i < palette.size(); ++i) {
+                Uint8* texel = &colours[(row * paletteSize.x + i) * 4];
+                texel[0] = palette[i].r;
+                texel[1] = palette[i].g;
+                texel[2] = palette[i].b;
+                texel[3] = palette[i].a;
+            }
+        }
+        if (!palettes.create(paletteSize.x, paletteSize.y)) {
+            throw runtime_error("Error creating the palettes of: " + name);
+        }
+        palettes.update(colours.data());
+        ResourceStats::getInstance().recordTextureUpload(paletteSize);
+        MemoryTracker::getInstance().track(&palettes, MemoryTracker::Type::Texture, name + " (palettes)",
+            static_cast<uint64_t>(paletteSize.x) * paletteSize.y * 4, memoryOwner);
+        getPaletteShader();  // compiled now rather than on the first frame shown
+    }
+}
+
+void SpriteSheet::draw(RenderTarget& target, Sprite& sprite, size_t frame) const {
+    if (frame >= slots.size()) return;
+    const Slot& slot = slots[frame];
+    if (sprite.getTexture() != &pages[slot.page]) sprite.setTexture(pages[slot.page]);
+    sprite.setTextureRect(slot.rect);
+
+    if (!paletted) {
+        FrameProfiler::draw(target, sprite);
+        return;
+    }
+    Shader& shader = getPaletteShader();
+    shader.setUniform("palette", palettes);
+    float channel[4] = { 0.f, 0.f, 0.f, 0.f };
+    channel[slot.channel] = 1.f;
+    shader.setUniform("channel", Glsl::Vec4(channel[0], channel[1], channel[2], channel[3]));
+    shader.setUniform("paletteRow", (frame + 0.5f) / slots.size());
+
+    RenderStates states;
+    states.texture = &pages[slot.page];  // the sprite binds it, named here for the profiler's bind count
+    states.shader = &shader;
+    FrameProfiler::draw(target, sprite, states);
+}
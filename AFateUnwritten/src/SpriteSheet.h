@@ -0,0 +1,52 @@
+#ifndef SPRITE_SHEET_H
+#define SPRITE_SHEET_H
+
+// SFML & Standard Library Includes
+#include <SFML/Graphics.hpp>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// handles: the frames of an animation packed into a few large textures (pages), uploaded once
+// playing the animation only changes the sprite's texture rect, so every frame on a page shares one texture bind
+// frames of up to 256 colours are stored as palette indices, four frames per texel (one per colour channel),
+// and a shader looks the colour up in the frame's palette row: a quarter of the video memory of RGBA frames.
+// frames with more colours (or no shader support) are stored as RGBA tiles instead
+class SpriteSheet {
+public:
+    // one decoded frame on its way into the sheet
+    struct Frame {
+        sf::Image image;                   // decoded pixels
+        std::vector<sf::Uint8> indices;    // palette index per pixel (empty: more than 256 colours)
+        std::vector<sf::Color> palette;    // the frame's colours, in index order
+    };
+    static void indexColours(Frame& frame);  // fills indices and palette from image (safe on JobSystem workers)
+
+    ~SpriteSheet();                          // releases the pages from the memory tracker
+
+    // packs the frames (all the same size) into pages and uploads them, counted for memoryOwner
+    void build(const std::vector<Frame>& frames, const std::string& name, const std::string& memoryOwner);
+    void release();                          // frees the pages
+
+    std::size_t getFrameCount() const { return slots.size(); }
+    sf::Vector2u getFrameSize() const { return frameSize; }
+    bool isPaletted() const { return paletted; }
+
+    // draws one frame with the sprite's transform, the sprite is pointed at the frame's page and rect
+    void draw(sf::RenderTarget& target, sf::Sprite& sprite, std::size_t frame) const;
+
+private:
+    // where a frame sits
+    struct Slot {
+        std::size_t page;                  // which of the pages
+        sf::IntRect rect;                  // its tile on the page
+        int channel;                       // colour channel holding its indices (paletted only)
+    };
+    std::vector<sf::Texture> pages;        // sized once per build, never copied
+    sf::Texture palettes;                  // 256 x frames: row n is the palette of frame n (paletted only)
+    std::vector<Slot> slots;               // by frame
+    sf::Vector2u frameSize;
+    bool paletted = false;
+};
+
+#endif
@@ -0,0 +1,156 @@
+#include "StartupReport.h"
+#include "JobSystem.h"
+#include "ResourceStats.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+
+using namespace std;
+
+// taken during static initialization, the closest portable point to process start
+static const chrono::steady_clock::time_point processStart = chrono::steady_clock::now();
+static const thread::id mainThreadId = this_thread::get_id();
+
+// phases currently open on this thread (for indenting nested phases)
+static thread_local int openPhases = 0;
+
+// report labels in the order of StartupReport::Kind
+static const char* kindNames[] = { "window", "scene", "font", "texture", "image", "sound", "music", "gif", "other" };
+
+static double millisecondsSinceStart(chrono::steady_clock::time_point time) {
+    return chrono::duration<double, milli>(time - processStart).count();
+}
+
+// singleton: get the single instance of StartupReport
+StartupReport& StartupReport::getInstance() {
+    static StartupReport instance;
+    return instance;
+}
+
+// scoped phase: starts timing
+StartupReport::Phase::Phase(Kind kind, const string& name)
+    : kind(kind), name(name), active(StartupReport::getInstance().isRecording()), depth(openPhases),
+    start(chrono::steady_clock::now()) {
+    openPhases++;
+}
+
+// scoped phase: hands the finished phase to the report
+StartupReport::Phase::~Phase() {
+    openPhases--;
+    if (!active) return;
+
+    Entry entry;
+    entry.kind = kind;
+    entry.name = name;
+    entry.startMs = millisecondsSinceStart(start);
+    entry.durationMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    entry.depth = depth;
+    entry.mainThread = this_thread::get_id() == mainThreadId;
+    entry.fileBytes = fileBytes;
+    entry.bytesRead = bytesRead;
+    StartupReport::getInstance().add(entry);
+}
+
+// looks up the size of a file the phase read (from the directory entry: opening it again would add to the timing)
+void StartupReport::Phase::addFile(const string& path, bool fullyRead) {
+    if (!active) return;
+
+    error_code error;
+    uint64_t size = static_cast<uint64_t>(filesystem::file_size(path, error));
+    if (error) return;
+    fileBytes += size;
+    if (fullyRead) {
+        bytesRead += size;
+    }
+}
+
+// phases are only collected until the report is written
+bool StartupReport::isRecording() const {
+    lock_guard<mutex> lock(entriesMutex);
+    return !finished;
+}
+
+void StartupReport::add(const Entry& entry) {
+    lock_guard<mutex> lock(entriesMutex);
+    if (!finished) {
+        entries.push_back(entry);
+    }
+}
+
+// the first presented frame ends startup: the report is formatted here and written on the job system
+void StartupReport::finish() {
+    string report;
+    {
+        lock_guard<mutex> lock(entriesMutex);
+        if (finished) return;
+        finished = true;
+        report = format(millisecondsSinceStart(chrono::steady_clock::now()));
+    }
+
+    JobSystem::getInstance().schedule([report] {
+        ofstream log("startup.log", ofstream::trunc);
+        ResourceStats::getInstance().recordFileWrite();
+        if (log.is_open()) {
+            log << report;
+        }
+    });
+}
+
+// builds the report: totals per kind, then every phase from slowest to fastest
+string StartupReport::format(double totalMs) const {
+    const int kindCount = static_cast<int>(Kind::Other) + 1;
+    int counts[kindCount] = {};
+    double kindMs[kindCount] = {};
+    uint64_t kindFileBytes[kindCount] = {};
+    uint64_t kindBytesRead[kindCount] = {};
+    double topLevelMs = 0.0;
+
+    for (const Entry& entry : entries) {
+        int k = static_cast<int>(entry.kind);
+        counts[k]++;
+        kindMs[k] += entry.durationMs;
+        kindFileBytes[k] += entry.fileBytes;
+        kindBytesRead[k] += entry.bytesRead;
+        if (entry.mainThread && entry.depth == 0) {
+            topLevelMs += entry.durationMs;
+        }
+    }
+
+    vector<const Entry*> sorted;
+    for (const Entry& entry : entries) {
+        sorted.push_back(&entry);
+    }
+    stable_sort(sorted.begin(), sorted.end(), [](const Entry* a, const Entry* b) {
+        return a->durationMs > b->durationMs;
+    });
+
+    ostringstream out;
+    out << fixed << setprecision(2);
+    out << "A Fate Unwritten startup report\n";
+    out << "first menu frame presented " << totalMs << " ms after process start\n";
+    out << "main thread outside any phase: " << max(0.0, totalMs - topLevelMs) << " ms\n\n";
+
+    out << "totals per kind (nested phases count towards their parents as well)\n";
+    out << left << setw(10) << "kind" << right << setw(8) << "count" << setw(12) << "total ms"
+        << setw(14) << "file bytes" << setw(14) << "bytes read" << "\n";
+    for (int k = 0; k < kindCount; ++k) {
+        if (counts[k] == 0) continue;
+        out << left << setw(10) << kindNames[k] << right << setw(8) << counts[k] << setw(12) << kindMs[k]
+            << setw(14) << kindFileBytes[k] << setw(14) << kindBytesRead[k] << "\n";
+    }
+
+    out << "\nphases by duration (fonts and music stream, so only their header is read at open; [job] ran on a worker)\n";
+    out << right << setw(10) << "ms" << setw(10) << "start ms" << "  " << left << setw(8) << "kind" << right
+        << setw(14) << "file bytes" << setw(14) << "bytes read" << "  name\n";
+    for (const Entry* entry : sorted) {
+        out << right << setw(10) << entry->durationMs << setw(10) << entry->startMs << "  "
+            << left << setw(8) << kindNames[static_cast<int>(entry->kind)] << right
+            << setw(14) << entry->fileBytes << setw(14) << entry->bytesRead << "  "
+            << string(entry->depth * 2, ' ') << entry->name << (entry->mainThread ? "" : " [job]") << "\n";
+    }
+    return out.str();
+}
@@ -0,0 +1,85 @@
+#ifndef STARTUP_REPORT_H
+#define STARTUP_REPORT_H
+
+// Standard Library Includes
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// handles: where cold start time goes, from process start to the first presented menu frame
+// window creation, scene constructors, resource opens and GIF decoding each record a Phase,
+// the first present() writes them sorted by duration to startup.log
+// note: phases nest (a scene constructor contains its resource loads), so durations don't add up
+class StartupReport {
+public:
+    // what a phase was doing
+    enum class Kind {
+        Window,         // creating the window / render target
+        Scene,          // a scene or screen constructor
+        Font,
+        Texture,
+        Image,          // decoded on the job system (GIF frames)
+        Sound,
+        Music,
+        Gif,            // GifAnimator::loadFrames (decode + upload of all frames)
+        Other
+    };
+
+    static StartupReport& getInstance();              // singleton pattern: one report per process
+
+    // scoped phase: records its duration if it ends before the report is written
+    class Phase {
+    public:
+        Phase(Kind kind, const std::string& name);
+        ~Phase();
+
+        // adds a file the phase read, fullyRead is false for streamed files (fonts, music)
+        // whose bytes are mostly read later on demand
+        void addFile(const std::string& path, bool fullyRead);
+
+        Phase(const Phase&) = delete;
+        Phase& operator=(const Phase&) = delete;
+
+    private:
+        Kind kind;
+        std::string name;
+        bool active;                                  // the report was still open when the phase began
+        int depth;                                    // phases open on this thread when it began
+        std::chrono::steady_clock::time_point start;
+        std::uint64_t fileBytes = 0;
+        std::uint64_t bytesRead = 0;
+    };
+
+    bool isRecording() const;                         // false once the report has been written
+    void finish();                                    // called on every present, writes the report the first time
+
+    StartupReport(const StartupReport&) = delete;
+    StartupReport& operator=(const StartupReport&) = delete;
+
+private:
+    // constructor: ensure singleton pattern
+    StartupReport() {}
+
+    // one finished phase
+    struct Entry {
+        Kind kind;
+        std::string name;
+        double startMs;                               // since process start
+        double durationMs;
+        int depth;
+        bool mainThread;                              // false for phases run on a job system worker
+        std::uint64_t fileBytes;
+        std::uint64_t bytesRead;
+    };
+
+    mutable std::mutex entriesMutex;                  // phases also end on job system workers
+    std::vector<Entry> entries;
+    bool finished = false;
+
+    void add(const Entry& entry);
+    std::string format(double totalMs) const;         // the report text
+};
+
+#endif
@@ -1,14 +1,20 @@
 ﻿#include "TextManager.h"
-#include <sstream>
 #include "ResizeManager.h"
 #include "LoadResources.h"
+#include "Input.h"
+#include "FrameProfiler.h"
+#include "Trace.h"
+#include "TextWrap.h"
+#include "NarrativeStore.h"
+
+#include <algorithm>
 
 using namespace std;
 using namespace sf;
 
 // constructor: initializes the text manager, sets up resources, and prepares dialogue settings
-TextManager::TextManager(RenderWindow& window, const string& text, const string& name)
-    : window(window), fullText(text), currentIndex(0), textComplete(false) {
+TextManager::TextManager(RenderTarget& window, string_view text, const string& name)
+    : window(window), fullText(text), sourceText(text), currentIndex(0), textComplete(false) {
     loadResources();       // load font and set up the text object
     handleTextWrapping();  // handle text wrapping to avoid overflow
     setComponentSize();    // set component sizes based on window
@@ -37,14 +43,10 @@ void TextManager::setComponentSize() {
     dialogueText.setPosition(ResizeManager::scalePosition(Vector2f(15.f, ResizeManager::BASE_RESOLUTION.y - 200.f), scale));
 }
 
-string TextManager::getFullDisplayedText() const {
-    return wrappedText.substr(0, currentIndex);  // return the full visible text up to the current index
-}
-
 // draws dialogue box and text onto window
 void TextManager::render() {
-    window.draw(dialogueBox);    // draw background for dialogue box
-    window.draw(dialogueText);   // draw the actual dialogue text
+    FrameProfiler::draw(window, dialogueBox);    // draw background for dialogue box
+    FrameProfiler::draw(window, dialogueText);   // draw the actual dialogue text
 }
 
 // returns whether entire text has been displayed or not
@@ -57,46 +59,48 @@ bool TextManager::awaitingChunk() const {
 }
 
 void TextManager::handleTextWrapping() {
+    FrameProfiler::Scope profile(FrameProfiler::Section::TextWrap);
+    Trace::Scope trace("TextManager::handleTextWrapping", "text");
+
     if (!originalText.empty())
         fullText = originalText;  // reset full text to original if available
 
-    textChunks.clear();   // clear any existing chunks
-    wrappedText.clear();  // reset wrapped text
-
-    Vector2f scale = ResizeManager::getScale(window);                  // get scale for text wrapping
-    float maxWidth = ResizeManager::BASE_RESOLUTION.x * scale.x - 30;  // maximum width for text wrapping
-    float maxHeight = 200 * scale.y - 20;                              // maximum height for text box
+    TextWrap::BoxMetrics box = TextWrap::getBoxMetrics(window.getSize());
 
-    Text tempText;
-    tempText.setFont(font);
-    tempText.setCharacterSize(dialogueText.getCharacterSize());  // set temp text to same font size
-
-    stringstream ss(fullText);
-    string word, currentLine, currentChunk;
-
-    // Wrap text into chunks based on window size
-    while (ss >> word) {
-        string testLine = currentLine + word + " ";
-        tempText.setString(testLine);                       // test the line length with the current word
-        if (tempText.getLocalBounds().width <= maxWidth) {  // if the line fits, continue adding to it
-            currentLine = testLine;
+    // story lines come pre-wrapped for the standard window sizes
+    NarrativeStore::Chunks prewrapped = NarrativeStore::getInstance().getPrewrappedChunks(sourceText, window.getSize(), box.characterSize);
+    if (!prewrapped.empty()) {
+        textChunks.resize(prewrapped.size());
+        wrappedText.clear();
+        for (size_t i = 0; i < prewrapped.size(); ++i) {
+            textChunks[i] = prewrapped[i];   // reuses the strings of the previous line
+            wrappedText += prewrapped[i];
         }
-        else {
-            currentChunk += currentLine + "\n";  // add the line to the chunk
-            wrappedText += currentLine + "\n";   // append to wrapped text
-            currentLine = word + " ";            // start new line with the current word
+    }
+    else {
+        const pair<unsigned int, unsigned int> size(window.getSize().x, window.getSize().y);
+        auto cached = wrapCache.find(size);
+        ++wrapUses;
+        if (cached != wrapCache.end()) {
+            cached->second.lastUse = wrapUses;
+            textChunks = cached->second.chunks;
+            wrappedText.clear();
+            for (const string& chunk : textChunks) {
+                wrappedText += chunk;            // the chunks hold every wrapped line
+            }
         }
-
-        tempText.setString(currentChunk + currentLine);
-        if (tempText.getLocalBounds().height > maxHeight) {  // if the chunk exceeds max height, split it
-            textChunks.push_back(currentChunk);
-            currentChunk.clear();
+        else {
+            // Wrap text into chunks based on window size
+            int measured = TextWrap::wrap(fullText, font, box, textChunks, wrappedText);
+            FrameProfiler::getInstance().count(FrameProfiler::Counter::SetString, measured);
+            if (wrapCache.size() >= 4) {  // a handful of sizes is all a player toggles between, the least recent goes
+                wrapCache.erase(min_element(wrapCache.begin(), wrapCache.end(), [](const auto& a, const auto& b) {
+                    return a.second.lastUse < b.second.lastUse;
+                }));
+            }
+            wrapCache.emplace(size, WrappedSize{ textChunks, wrapUses });
         }
     }
-
-    currentChunk += currentLine;         // add any remaining text
-    wrappedText += currentLine;
-    textChunks.push_back(currentChunk);  // store the last chunk
     fullText = wrappedText;              // update full text with wrapped text
 }
 
@@ -107,7 +111,7 @@ void TextManager::typeText() {
 
     if (currentIndex < chunk.size()) {        // if not all characters are displayed in the chunk
         currentText += chunk[currentIndex];   // add one character at a time
-        dialogueText.setString(currentText);  // update the text object
+        FrameProfiler::setString(dialogueText, currentText); // update the text object
         currentIndex++;                       // move to the next character
     }
     else {
@@ -122,7 +126,7 @@ void TextManager::typeText() {
 
 void TextManager::fillBox() {
     currentText = textChunks[currentChunkIndex];      // immediately fill the box with current chunk
-    dialogueText.setString(currentText);              // update text object with the chunk
+    FrameProfiler::setString(dialogueText, currentText); // update text object with the chunk
     currentIndex = currentText.size();                // mark the chunk as fully displayed
 
     if (currentChunkIndex < textChunks.size() - 1) {  // if more chunks left, prepare for next chunk
@@ -134,15 +138,15 @@ void TextManager::fillBox() {
 
 void TextManager::update() {
     // handle advancing to the next chunk (ENTER or RIGHT arrow key)
-    bool enterPressedNow = Keyboard::isKeyPressed(Keyboard::Enter);
+    bool enterPressedNow = Input::getInstance().isKeyPressed(Keyboard::Enter);
 
-    if ((enterPressedNow && !enterPressed) || Keyboard::isKeyPressed(Keyboard::Right)) {
+    if ((enterPressedNow && !enterPressed) || Input::getInstance().isKeyPressed(Keyboard::Right)) {
         if (awaitingNextChunk) {
             currentChunkIndex++;   // move to the next chunk
             currentText.clear();   // clear current text display
             currentIndex = 0;      // reset the index for typing
             awaitingNextChunk = false;
-            dialogueText.setString("");  // clear dialogue text
+            FrameProfiler::setString(dialogueText, ""); // clear dialogue text
         }
         else if (awaitingFinalConfirm) {
             textComplete = true;   // confirm text is complete
@@ -173,6 +177,38 @@ void TextManager::reset() {
     handleTextWrapping();         // re-wrap text for a fresh start
 }
 
+// next line of dialogue: same as a reset, but with new text and an empty text box
+void TextManager::setText(string_view text) {
+    fullText.assign(text.data(), text.size());  // keeps the buffer of the previous line
+    sourceText = text;
+    wrapCache.clear();                          // measured for the previous text
+    FrameProfiler::setString(dialogueText, "");
+    reset();
+}
+
+SceneSnapshot::Typing TextManager::getTypingState() const {
+    SceneSnapshot::Typing state;
+    state.chunk = currentChunkIndex;
+    state.typed = static_cast<uint32_t>(currentIndex);
+    state.awaitingNextChunk = awaitingNextChunk;
+    state.awaitingFinalConfirm = awaitingFinalConfirm;
+    state.complete = textComplete;
+    return state;
+}
+
+// puts the box where a save left it, on top of setText (the page is re-wrapped for this window, so clamp)
+void TextManager::setTypingState(const SceneSnapshot::Typing& state) {
+    if (textChunks.empty()) return;
+    currentChunkIndex = std::clamp(state.chunk, 0, static_cast<int>(textChunks.size()) - 1);
+    currentIndex = std::min<size_t>(state.typed, textChunks[currentChunkIndex].size());
+    currentText = textChunks[currentChunkIndex].substr(0, currentIndex);
+    FrameProfiler::setString(dialogueText, currentText);
+    awaitingNextChunk = state.awaitingNextChunk && currentChunkIndex < static_cast<int>(textChunks.size()) - 1;
+    awaitingFinalConfirm = state.awaitingFinalConfirm;
+    textComplete = state.complete;
+    enterPressed = true;  // the Enter that picked "Load" mustn't skip ahead
+}
+
 void TextManager::resize() {
     setComponentSize();          // adjust component size
     handleTextWrapping();        // re-wrap text based on new window size
@@ -181,6 +217,6 @@ void TextManager::resize() {
     if (currentChunkIndex < textChunks.size()) {
         string& currentChunk = textChunks[currentChunkIndex];
         currentText = currentChunk.substr(0, currentIndex);  // restore typed text so far
-        dialogueText.setString(currentText);                 // update text object
+        FrameProfiler::setString(dialogueText, currentText); // update text object
     }
 }
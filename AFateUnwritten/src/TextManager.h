@@ -4,17 +4,24 @@
 // SFML & standard library includes
 #include <SFML/Graphics.hpp>
 #include <string>
+#include <string_view>
 #include <vector>
+#include <map>
+#include <utility>
+
+// project includes
+#include "SceneSnapshot.h"
 
 // handles: dialogue text rendering, text animation, and wrapping for the game
 class TextManager {
 public:
     // -- constructor --
     // initializes text manager with window and text
-    TextManager(sf::RenderWindow& window, const std::string& text, const std::string& name = "");
+    TextManager(sf::RenderTarget& window, std::string_view text, const std::string& name = "");
 
     // -- helper methods --
-    std::string getFullDisplayedText() const; // returns the full visible text displayed so far
+    const std::string& getDisplayedText() const { return currentText; } // text in the box right now (part of the current chunk)
+    int getChunkIndex() const { return currentChunkIndex; }             // which chunk of the line is in the box
 
     // -- text handling methods --
     std::string wrappedText;             // used in handleTextWrapping to store wrapped text
@@ -23,26 +30,33 @@ public:
     void update();                       // updates the text (one character at a time)
     void typeText();                     // adds one character at a time (simulates typing)
     void handleTextWrapping();           // handles text wrapping to avoid overflow
+    void forgetWrappedSizes() { wrapCache.clear(); } // the next wrap measures again (MicroBench times the cold wrap with it)
     void render();                       // renders text and dialogue box on the window
     bool isTextComplete() const;         // checks if all the text has been fully displayed
 
     // -- reset and advance --
     void reset();                        // resets the text manager state for reuse in another level
+    void setText(std::string_view text); // replaces the text and starts typing it from the beginning (keeps font and shapes)
     void fillBox();                      // immediately fills the box with text up to the overflow point
     bool awaitingChunk() const;          // checks if the dialogue is awaiting the next chunk of text
 
+    // -- save and resume --
+    SceneSnapshot::Typing getTypingState() const;           // how far the current text has been typed
+    void setTypingState(const SceneSnapshot::Typing& state); // jumps to that point of the current text (clamped to it)
+
     // -- responsive UI support --
     void resize();                       // resizes text and components when the window size changes
 
 private:
     // -- window and component setup --
-    sf::RenderWindow& window;            // main window object for rendering text and graphics
+    sf::RenderTarget& window;            // main window object for rendering text and graphics
     sf::Font font;                       // sfml font object, defines the text appearance
     sf::RectangleShape dialogueBox;      // sfml rectangle shape for the background of the dialogue box
     sf::Text dialogueText;               // sfml text object holding the dialogue text
     sf::Text nameText;                   // text object for displaying the character's name
     sf::RectangleShape nameBackground;   // background rectangle for the character's name tag
     std::string fullText;                // full block of text for dialogue
+    std::string_view sourceText;         // text as handed in (story lines point into NarrativeStore, which may have it pre-wrapped)
     std::string currentText;             // currently visible text, revealed progressively
     std::string characterName;           // name of the character currently speaking
     std::string originalText;            // original text before any modifications (for wrapping)
@@ -54,6 +68,14 @@ private:
 
     // -- text chunk management --
     std::vector<std::string> textChunks; // stores chunks of the text after wrapping
+    // chunks of the current text per window size it was measured at (not pre-wrapped sizes), dropped by setText
+    // so restarting the line or resizing back to an earlier size doesn't measure it again
+    struct WrappedSize {
+        std::vector<std::string> chunks;
+        unsigned int lastUse = 0;        // wrapUses when the size was last shown (the oldest one makes room)
+    };
+    std::map<std::pair<unsigned int, unsigned int>, WrappedSize> wrapCache;
+    unsigned int wrapUses = 0;           // counts cache lookups, orders the sizes by last use
     int currentChunkIndex = 0;           // tracks which chunk is currently being displayed
     bool enterPressed = false;           // flag to detect if the enter key is pressed
     bool rightPressed = false;           // flag to detect if the right arrow key is pressed
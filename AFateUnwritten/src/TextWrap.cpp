@@ -0,0 +1,58 @@
+#include "TextWrap.h"
+#include "ResizeManager.h"
+
+#include <algorithm>
+#include <sstream>
+
+using namespace std;
+using namespace sf;
+
+// dialogue box of TextManager: full width, 200 px tall at the base resolution, 40 px text
+TextWrap::BoxMetrics TextWrap::getBoxMetrics(Vector2u windowSize) {
+    Vector2f scale = ResizeManager::getScale(windowSize);
+    BoxMetrics box;
+    box.characterSize = static_cast<unsigned int>(ResizeManager::scaleText(40, min(scale.x, scale.y)));
+    box.maxWidth = ResizeManager::BASE_RESOLUTION.x * scale.x - 30;
+    box.maxHeight = 200 * scale.y - 20;
+    return box;
+}
+
+int TextWrap::wrap(const string& text, const Font& font, const BoxMetrics& box, vector<string>& chunks, string& wrapped) {
+    chunks.clear();
+    wrapped.clear();
+
+    Text tempText;
+    tempText.setFont(font);
+    tempText.setCharacterSize(box.characterSize);
+    int measured = 0;
+
+    stringstream ss(text);
+    string word, currentLine, currentChunk;
+
+    // Wrap text into chunks based on window size
+    while (ss >> word) {
+        string testLine = currentLine + word + " ";
+        tempText.setString(testLine);                            // test the line length with the current word
+        measured++;
+        if (tempText.getLocalBounds().width <= box.maxWidth) {  // if the line fits, continue adding to it
+            currentLine = testLine;
+        }
+        else {
+            currentChunk += currentLine + "\n";  // add the line to the chunk
+            wrapped += currentLine + "\n";       // append to wrapped text
+            currentLine = word + " ";            // start new line with the current word
+        }
+
+        tempText.setString(currentChunk + currentLine);
+        measured++;
+        if (tempText.getLocalBounds().height > box.maxHeight) {  // if the chunk exceeds max height, split it
+            chunks.push_back(currentChunk);
+            currentChunk.clear();
+        }
+    }
+
+    currentChunk += currentLine;         // add any remaining text
+    wrapped += currentLine;
+    chunks.push_back(currentChunk);      // store the last chunk
+    return measured;
+}
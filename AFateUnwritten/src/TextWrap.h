@@ -0,0 +1,27 @@
+#ifndef TEXT_WRAP_H
+#define TEXT_WRAP_H
+
+// SFML & Standard Library Includes
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <vector>
+
+// handles: breaking dialogue into lines and box-sized chunks. shared by TextManager (at runtime) and
+// NarrativeCompiler (which pre-wraps the story for standard window sizes), so both produce the same chunks
+namespace TextWrap {
+    // size of the dialogue text and the box it has to fit in, for one window size
+    struct BoxMetrics {
+        unsigned int characterSize;
+        float maxWidth;                 // of a line
+        float maxHeight;                // of a chunk
+    };
+
+    BoxMetrics getBoxMetrics(sf::Vector2u windowSize);
+
+    // wraps text at word boundaries into chunks that fit the box, wrapped gets every line
+    // returns how many strings were measured (each one an sf::Text::setString)
+    int wrap(const std::string& text, const sf::Font& font, const BoxMetrics& box,
+        std::vector<std::string>& chunks, std::string& wrapped);
+}
+
+#endif
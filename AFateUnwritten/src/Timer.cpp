@@ -1,40 +1,40 @@
 #include "Timer.h"
-#include "LoadResources.h"
 #include "ResizeManager.h"
+#include "GameClock.h"
+#include "FrameProfiler.h"
 #include <SFML/Graphics.hpp>
 
 using namespace std;
 using namespace sf;
 
-// constructor: initializes the timer with a reference to the window and the starting time (in seconds)
-Timer::Timer(RenderWindow& window, float seconds) {
+// constructor: initializes the timer with a reference to the window, the starting time (in seconds) and its GameClock name
+Timer::Timer(RenderTarget& window, float seconds, const string& name) {
+    GameClock::getInstance();          // created first so it outlives the timer
     this->window = &window;            // save pointer to window
+    this->name = name;                 // the GameClock timer counting for this one
     this->seconds = seconds;           // total time for the timer
     this->initialTime = seconds;       // remember the original set time for reset
-    this->complete = false;            // timer is not complete at start
     this->remainingTime = seconds;     // remaining time initially equals total time
-    this->stopped = true;              // timer is initially stopped
-
-    clock.restart();                   // restart the internal clock
-
-    resourceLoader(font, "resources/fonts/INFROMAN.ttf"); // load font for displaying the timer
 
     // set up the appearance of the timer text
-    timerText.setFont(font);
+    timerText.setFont(SdfFont::get(SdfFont::uiFontPath));
     timerText.setCharacterSize(50);
     timerText.setFillColor(Color::White);
     timerText.setPosition(10, 10);
 }
 
+// destructor: the clock forgets the timer
+Timer::~Timer() {
+    GameClock::getInstance().removeTimer(name);
+}
+
 // Updates the timer countdown
 void Timer::update() {
-    float elapsedTime = clock.getElapsedTime().asSeconds();  // get time elapsed since timer started
-    remainingTime = (seconds + 1) - elapsedTime;             // calculate remaining time (+1 for smoother display)
+    remainingTime = (seconds + 1) - getElapsedTime();        // calculate remaining time (+1 for smoother display)
 
     if (remainingTime <= 0.0f) {
         // Timer has expired
         remainingTime = 0.0f;
-        complete = true;
     }
     else if (remainingTime <= (seconds / 6)) {
         // if time left is less than 1/6 of total, change text color to red (warning)
@@ -44,7 +44,7 @@ void Timer::update() {
 
 // draws the timer on the screen
 void Timer::render() {
-    if (!stopped) {
+    if (isRunning()) {
         update(); // update the timer first before drawing
 
         // handle scaling for different window sizes
@@ -54,29 +54,39 @@ void Timer::render() {
         // apply scaling to timer text
         timerText.setCharacterSize(static_cast<unsigned int>(scaledSize));
         timerText.setPosition(ResizeManager::scalePosition({ 10.0f, 10.0f }, scale));
-        timerText.setString("Time Left: " + to_string(static_cast<int>(remainingTime))); // update displayed text
+        FrameProfiler::setString(timerText, "Time Left: " + to_string(static_cast<int>(remainingTime))); // update displayed text
 
-        window->draw(timerText); // draw the timer text
+        FrameProfiler::draw(*window, timerText); // draw the timer text
     }
 }
 
-// returns true if the timer has completed
+// returns true if the timer has completed, the clock expires it in the tick that reaches zero
 bool Timer::isComplete() {
-    return complete;
+    return GameClock::getInstance().hasTimerExpired(name);
+}
+
+bool Timer::isRunning() const {
+    return GameClock::getInstance().isTimerRunning(name);
+}
+
+float Timer::getElapsedTime() const {
+    return GameClock::getInstance().getTimerElapsed(name);
 }
 
 // stops the timer (pauses updating and rendering)
 void Timer::stop() {
-    stopped = true;
+    GameClock::getInstance().stopTimer(name);
 }
 
 // resets the timer back to its original time and starts counting again
 void Timer::reset() {
+    resumeAt(0.0f);
+}
+
+// restarts the timer part way through, for a resumed save
+void Timer::resumeAt(float elapsed) {
     seconds = initialTime;
-    remainingTime = initialTime;
-    stopped = false;
-    complete = false;
-    clock.restart(); // restart the internal clock
+    GameClock::getInstance().startTimer(name, seconds + 1, elapsed); // +1 like the display, it shows 0 only at the very end
     timerText.setFillColor(Color::White); // reset text color to white
     update(); // immediately update the displayed time
 }
@@ -3,38 +3,43 @@
 
 #include <SFML/Graphics.hpp>
 #include <sstream>
+#include <string>
+
+#include "SdfText.h"
 
 // handles countdown timing, updating, rendering, and control (start/stop/reset)
+// the counting is a named GameClock timer, so the countdown stands still while the game is paused
 class Timer {
 public:
     // -- constructor --
-    Timer(sf::RenderWindow& window, float seconds);  // sets up timer with window reference and starting time
+    Timer(sf::RenderTarget& window, float seconds, const std::string& name); // sets up timer with window reference, starting time and GameClock timer name
+    ~Timer();            // removes the GameClock timer
 
     // -- core functionality --
-    void update();       // updates the countdown timer each frame
+    void update();       // recalculates the remaining time from the game time elapsed
     void render();       // renders the timer text onto the window
-    bool isComplete();   // returns true if the timer has reached zero
+    bool isComplete();   // returns true if the timer has reached zero (as of this frame's tick)
 
     // -- control methods --
     void stop();         // stops the timer
     void reset();        // resets the timer to its initial time
 
+    // -- save and resume --
+    bool isRunning() const;                              // counting down (reset and not stopped since)
+    float getElapsedTime() const;                        // game seconds counted since the last reset
+    void resumeAt(float elapsed); // restarts the countdown as if elapsed seconds had already gone by
+
 private:
     // -- core components --
-    sf::RenderWindow* window;   // pointer to the window for rendering the timer text
-    sf::Clock clock;            // SFML clock to measure elapsed time
-    sf::Font font;              // font used to display the timer
-    sf::Text timerText;         // text object showing the remaining time
+    sf::RenderTarget* window;   // pointer to the window for rendering the timer text
+    std::string name;           // GameClock timer doing the counting
+    SdfText timerText;          // text object showing the remaining time (rescaled every frame, no glyph page per size)
     std::stringstream ss;       // used to format the timer text
 
     // -- timing variables --
     float seconds;              // number of seconds since last frame (delta time)
     float remainingTime;        // how much time is left in the countdown
     float initialTime;          // the original starting time (for resets)
-
-    // -- state flags --
-    bool complete;              // true if timer has finished counting down
-    bool stopped;               // true if timer is currently paused
 };
 
 #endif
@@ -0,0 +1,192 @@
+#include "Trace.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+
+using namespace std;
+
+const size_t Trace::bufferSize;
+const size_t Trace::detailSize;
+
+// singleton: get the single instance of Trace
+Trace& Trace::getInstance() {
+    static Trace instance;
+    return instance;
+}
+
+// constructor: the trace origin is the first time anything asks for the trace (early in main)
+Trace::Trace() : origin(chrono::steady_clock::now()) {}
+
+// scoped event without detail
+Trace::Scope::Scope(const char* name, const char* category)
+    : name(name), category(category), active(Trace::getInstance().isEnabled()) {
+    if (active) {
+        Trace::getInstance().begin(name, category);
+    }
+}
+
+// scoped event with detail (shown in the event's args)
+Trace::Scope::Scope(const char* name, const char* category, const string& detail)
+    : name(name), category(category), active(Trace::getInstance().isEnabled()) {
+    if (active) {
+        Trace::getInstance().begin(name, category, detail.c_str());
+    }
+}
+
+// scoped event: closes the event even if tracing stopped in between, so begin/end stay paired
+Trace::Scope::~Scope() {
+    if (active) {
+        Trace::getInstance().end(name, category);
+    }
+}
+
+// drops the events of a previous run and starts recording
+void Trace::start() {
+    {
+        lock_guard<mutex> lock(registryMutex);
+        for (auto& buffer : buffers) {
+            lock_guard<mutex> bufferLock(buffer->mutex);
+            buffer->written = 0;
+        }
+    }
+    enabled = true;
+}
+
+// stops recording
+void Trace::stop() {
+    enabled = false;
+}
+
+// records a begin event on the calling thread
+void Trace::begin(const char* name, const char* category, const char* detail) {
+    if (isEnabled()) {
+        record('B', name, category, detail);
+    }
+}
+
+// records an end event on the calling thread
+void Trace::end(const char* name, const char* category) {
+    record('E', name, category, nullptr);
+}
+
+// names the calling thread's row in the trace viewer
+void Trace::setThreadName(const string& name) {
+    ThreadBuffer& buffer = localBuffer();
+    lock_guard<mutex> lock(buffer.mutex);
+    buffer.threadName = name;
+}
+
+// every thread gets its own buffer the first time it records, registered so the exporter can find it
+Trace::ThreadBuffer& Trace::localBuffer() {
+    static thread_local ThreadBuffer* buffer = nullptr;
+    if (!buffer) {
+        auto created = make_shared<ThreadBuffer>();
+        lock_guard<mutex> lock(registryMutex);
+        created->threadId = static_cast<int>(buffers.size()) + 1;
+        buffers.push_back(created);
+        buffer = created.get();
+    }
+    return *buffer;
+}
+
+// writes one event into the thread's ring, overwriting the oldest when full
+void Trace::record(char phase, const char* name, const char* category, const char* detail) {
+    int64_t now = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - origin).count();
+    ThreadBuffer& buffer = localBuffer();
+
+    lock_guard<mutex> lock(buffer.mutex);  // only contended while exporting
+    if (buffer.events.empty()) {
+        buffer.events.resize(bufferSize);  // allocated on the first event, naming a thread costs nothing
+    }
+    Event& event = buffer.events[buffer.written % bufferSize];
+    event.phase = phase;
+    event.name = name;
+    event.category = category;
+    event.timeNs = now;
+    size_t length = 0;
+    if (detail) {
+        length = min(strlen(detail), detailSize - 1);  // not strncpy: deprecated under /sdl
+        memcpy(event.detail, detail, length);
+    }
+    event.detail[length] = '\0';
+    buffer.written++;
+}
+
+// writes a string as a JSON string literal
+static void writeJsonString(ostream& out, const char* text) {
+    out << '"';
+    for (const char* c = text; *c; ++c) {
+        switch (*c) {
+            case '"':  out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(*c) >= 0x20) out << *c;
+                break;
+        }
+    }
+    out << '"';
+}
+
+// exports every buffered event in the Chrome trace event format (also read by Perfetto)
+// when a ring wrapped, end events whose begin was overwritten are left out
+bool Trace::writeChromeJson(const string& path) {
+    ofstream file(path, ofstream::trunc);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    file << fixed << setprecision(3);
+    bool first = true;
+    auto separator = [&]() {
+        if (!first) file << ",\n";
+        first = false;
+    };
+
+    lock_guard<mutex> lock(registryMutex);
+    for (auto& buffer : buffers) {
+        lock_guard<mutex> bufferLock(buffer->mutex);
+
+        if (!buffer->threadName.empty()) {
+            separator();
+            file << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << buffer->threadId
+                << ",\"args\":{\"name\":";
+            writeJsonString(file, buffer->threadName.c_str());
+            file << "}}";
+        }
+
+        size_t count = min(buffer->written, bufferSize);
+        size_t oldest = buffer->written - count;
+        int depth = 0;
+        for (size_t i = oldest; i < buffer->written; ++i) {
+            const Event& event = buffer->events[i % bufferSize];
+            if (event.phase == 'E') {
+                if (depth == 0) continue;  // its begin was overwritten
+                depth--;
+            }
+            else {
+                depth++;
+            }
+
+            separator();
+            file << "{\"ph\":\"" << event.phase << "\",\"pid\":1,\"tid\":" << buffer->threadId
+                << ",\"ts\":" << event.timeNs / 1000.0 << ",\"name\":";
+            writeJsonString(file, event.name);
+            file << ",\"cat\":";
+            writeJsonString(file, event.category);
+            if (event.detail[0] != '\0') {
+                file << ",\"args\":{\"detail\":";
+                writeJsonString(file, event.detail);
+                file << "}";
+            }
+            file << "}";
+        }
+    }
+
+    file << "\n]}\n";
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,87 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+// Standard Library Includes
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// handles: timeline tracing (loads, scene construction, blocking waits) exported as Chrome trace JSON
+// every thread writes begin/end events into its own ring buffer, so tracing never waits on another thread
+// the file opens in chrome://tracing or ui.perfetto.dev, one row per thread
+// note: while tracing is off a Scope costs a single atomic load
+class Trace {
+public:
+    static Trace& getInstance();                      // singleton pattern: one trace for the whole process
+
+    // scoped event: a begin event on construction and the matching end event on destruction
+    // name and category must be string literals (only the pointer is stored), detail is copied
+    class Scope {
+    public:
+        Scope(const char* name, const char* category);
+        Scope(const char* name, const char* category, const std::string& detail);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        const char* name;
+        const char* category;
+        bool active;                                  // tracing was on when the scope began
+    };
+
+    // -- control --
+    void start();                                     // clears old events and starts recording
+    void stop();                                      // stops recording, the events stay until the next start
+    bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+    // -- recording --
+    void begin(const char* name, const char* category, const char* detail = nullptr);
+    void end(const char* name, const char* category);
+    void setThreadName(const std::string& name);      // label for the calling thread's row
+
+    // -- export --
+    bool writeChromeJson(const std::string& path);    // writes every buffered event (false if the file can't be opened)
+
+    Trace(const Trace&) = delete;
+    Trace& operator=(const Trace&) = delete;
+
+private:
+    // constructor: ensure singleton pattern, timestamps count from here
+    Trace();
+
+    static const std::size_t bufferSize = 8192;       // events kept per thread, the oldest get overwritten
+    static const std::size_t detailSize = 64;         // characters of detail kept per event
+
+    struct Event {
+        char phase = 'B';                             // 'B' begin or 'E' end
+        const char* name = nullptr;
+        const char* category = nullptr;
+        std::int64_t timeNs = 0;                      // since the trace origin
+        char detail[detailSize] = {};                 // e.g. the file being loaded
+    };
+
+    // events of one thread, only that thread writes (the mutex is for the exporter)
+    struct ThreadBuffer {
+        std::mutex mutex;
+        std::vector<Event> events;                    // ring of bufferSize events
+        std::size_t written = 0;                      // events written since start (may exceed bufferSize)
+        int threadId = 0;
+        std::string threadName;
+    };
+
+    std::atomic<bool> enabled{ false };
+    std::chrono::steady_clock::time_point origin;     // time zero of the trace
+    std::mutex registryMutex;                         // guards buffers
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers; // kept after their thread exits so nothing is lost
+
+    ThreadBuffer& localBuffer();                      // the calling thread's buffer, created on first use
+    void record(char phase, const char* name, const char* category, const char* detail);
+};
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef TRIGGER_AUTOMATON_H
+#define TRIGGER_AUTOMATON_H
+
+// Standard Library Includes
+#include <cstdint>
+#include <string_view>
+
+// project includes
+#include "NarrativeFormat.h"
+
+// handles: spotting a chapter's background trigger phrases while its dialogue is typed, one character at a time
+// NarrativeCompiler builds the automaton (every phrase at once, overlaps resolved) and NarrativeStore hands out
+// views of it straight from narrative.bin, so a character costs two table lookups and nothing is built at startup
+// line breaks leave the state alone: a phrase still matches when wrapping put a break inside it
+class TriggerAutomaton {
+public:
+    TriggerAutomaton() {}
+    TriggerAutomaton(const std::uint32_t* classes, std::uint32_t columnCount, const std::uint32_t* transitions,
+        const NarrativeFormat::StateRecord* states, const std::uint32_t* matches, const std::string_view* phrases,
+        std::uint32_t triggerCount)
+        : classes(classes), columnCount(columnCount), transitions(transitions), states(states), matches(matches),
+        phrases(phrases), triggerCount(triggerCount) {}
+
+    static const std::uint32_t start = 0;                     // state before any text
+
+    // state after reading c in state
+    std::uint32_t step(std::uint32_t state, char c) const {
+        return transitions[state * columnCount + classes[static_cast<unsigned char>(c)]];
+    }
+
+    // triggers whose phrase was just completed in state
+    std::uint32_t getMatchCount(std::uint32_t state) const { return triggerCount ? states[state].matchCount : 0; }
+    std::uint32_t getMatch(std::uint32_t state, std::uint32_t index) const { return matches[states[state].firstMatch + index]; }
+
+    std::uint32_t size() const { return triggerCount; }       // triggers of the chapter
+    bool empty() const { return triggerCount == 0; }
+    std::string_view getPhrase(std::uint32_t trigger) const { return phrases[trigger]; }
+
+private:
+    const std::uint32_t* classes = nullptr;                   // byte -> column
+    std::uint32_t columnCount = 0;
+    const std::uint32_t* transitions = nullptr;               // row per state
+    const NarrativeFormat::StateRecord* states = nullptr;
+    const std::uint32_t* matches = nullptr;
+    const std::string_view* phrases = nullptr;                // the chapter's trigger phrases
+    std::uint32_t triggerCount = 0;
+};
+
+#endif
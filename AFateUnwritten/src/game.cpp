@@ -3,86 +3,279 @@
 #include <memory>
 #include <chrono>
 #include <thread>
-#include <fstream>
+#include <algorithm>
 
 #include "Game.h"
 #include "RetryScreen.h"
 #include "LoadScreen.h"
 #include "LoadResources.h"
+#include "JobSystem.h"
+#include "SaveService.h"
+#include "GameEvents.h"
+#include "Input.h"
+#include "GameClock.h"
+#include "FrameProfiler.h"
+#include "Trace.h"
+#include "StartupReport.h"
+#include "ResizeManager.h"
+#include "MemoryTracker.h"
 
 using namespace std;
 using namespace sf;
 
-// constructor: sets up the window and all the game scenes
-Game::Game()
-    : window(VideoMode(1408, 728), "A Fate Unwritten")
-    , chapterTitleScreens(window)
+// constructs a scene or screen inside a trace event and startup phase (constructors are where the resources load)
+// the memory it loads is counted for name, replacing whatever the previous instance held
+template <typename T, typename Target>
+static unique_ptr<T> makeTraced(const char* name, Target& target) {
+    Trace::Scope trace(name, "scene");
+    StartupReport::Phase phase(StartupReport::Kind::Scene, name);
+    MemoryTracker::OwnerScope owner(name);
+    return make_unique<T>(target);
+}
+
+// restarts a scene in place (state only, its resources stay loaded), traced so retries show up on the timeline
+template <typename T>
+static void resetTraced(const char* name, T& scene) {
+    Trace::Scope trace(name, "reset");
+    scene.reset();
+}
+
+// blocking pause between scenes, traced so it shows up on the timeline
+// the wait ends up in the next frame's delta, game time skips that frame
+static void sleepTraced(chrono::milliseconds duration) {
+    Trace::Scope trace("sleep", "blocking");
+    this_thread::sleep_for(duration);
+    GameClock::getInstance().skipNextTick();
+}
+
+// constructor: sets up the render target and all the game scenes
+Game::Game(RenderMode mode)
+    : renderMode(mode)
+    , nullTarget(Vector2u(1408, 728))
+    , target(initTarget())
+    , chapterTitleScreens(target)
     , currentScene(Scene::Menu)
-    , menuScene(make_unique<Menu>(window))
-    , introScene(make_unique<Intro>(window))
-    , lionScene(make_unique<Lion>(window))
-    , scarecrowScene(make_unique<Scarecrow>(window))
-    , tinmanScene(make_unique<Tinman>(window))
-    , outroScene(make_unique<Outro>(window))
-    , pauseMenu(make_unique<PauseMenu>(window))
-    , controlScreen(make_unique<ControlScreen>(window))
-    , retryScreen(make_unique<RetryScreen>(window))
-    , loadScreen(make_unique<LoadScreen>(window))
+    , menuScene(makeTraced<Menu>("Menu", target))
+    , introScene(makeTraced<Intro>("Intro", target))
+    , lionScene(makeTraced<Lion>("Lion", target))
+    , scarecrowScene(makeTraced<Scarecrow>("Scarecrow", target))
+    , tinmanScene(makeTraced<Tinman>("Tinman", target))
+    , outroScene(makeTraced<Outro>("Outro", target))
+    , pauseMenu(makeTraced<PauseMenu>("PauseMenu", window))
 {
+    sceneLayoutSize.fill(target.getSize());       // the constructors laid every scene out
+    pauseMenuLayoutSize = window.getSize();
+
+    // the chapter scenes say when their last line is done, switchScene only has to look at the flag
+    chapterCompleted = EventBus::getInstance().subscribe<ChapterCompleted>([this](const ChapterCompleted&) {
+        chapterComplete = true;  // only the current scene is updated, so it is the current chapter
+    });
+
+    // initial scene music
+    updateSceneMusic(); 
+}
+
+// destructor: the bus outlives the game
+Game::~Game() {
+    EventBus::getInstance().unsubscribe<ChapterCompleted>(chapterCompleted);
+}
+
+// creates the target the scenes render into, headless modes never open a window
+RenderTarget& Game::initTarget() {
+    Trace::Scope trace("Game::initTarget", "startup");
+    StartupReport::Phase phase(StartupReport::Kind::Window, "render target");
+    switch (renderMode) {
+        case RenderMode::Offscreen:
+            if (!offscreen.create(1408, 728)) {
+                throw runtime_error("Error: Offscreen render target failed to create!");
+            }
+            Input::getInstance().setWindow(nullptr);
+            return offscreen;
+        case RenderMode::Null:
+            Input::getInstance().setWindow(nullptr);
+            return nullTarget;
+        case RenderMode::Letterbox: {
+            openWindow();
+            Vector2u size = getLetterboxFrameSize();
+            if (!offscreen.create(size.x, size.y)) {
+                throw runtime_error("Error: Letterbox render target failed to create!");
+            }
+            offscreen.setSmooth(true);  // filtered when the window shows it smaller
+            updateLetterbox(window.getSize());
+            return offscreen;
+        }
+        default:
+            openWindow();
+            return window;
+    }
+}
+
+// opens the game window, input is read from it
+void Game::openWindow() {
+    window.create(VideoMode(1408, 728), "A Fate Unwritten");
     // make sure the window was created successfully
     if (!window.isOpen()) {
         throw runtime_error("Error: Window failed to open!");
     }
-    // initial scene music
-    updateSceneMusic(); 
+    Input::getInstance().setWindow(&window);
 }
 
-// writes the player's progress to a file
-void Game::saveProgress() {
-    std::ofstream saveFile("savegame.txt");
-    if (saveFile.is_open()) {
-        GameScore& score = GameScore::getInstance();
-        saveFile << static_cast<int>(currentScene) << "\n";
-        saveFile << score.getScore(GameScore::ScoreType::LION) << "\n";
-        saveFile << score.getScore(GameScore::ScoreType::SCARECROW) << "\n";
-        saveFile << score.getScore(GameScore::ScoreType::TINMAN) << "\n";
-        saveFile.close();
+// the letterbox frame is laid out and rendered once at the largest size it can appear at: the desktop, keeping
+// the 1408x728 aspect. its text is rasterized at that size for good, smaller windows show the frame scaled down
+Vector2u Game::getLetterboxFrameSize() {
+    const Vector2f base = ResizeManager::BASE_RESOLUTION;
+    VideoMode desktop = VideoMode::getDesktopMode();
+    float scale = max(1.0f, min(desktop.width / base.x, desktop.height / base.y));
+    return Vector2u(static_cast<unsigned int>(base.x * scale + 0.5f), static_cast<unsigned int>(base.y * scale + 0.5f));
+}
+
+// fits the frame into the window at its aspect, with bars on the sides or at the top and bottom
+void Game::updateLetterbox(Vector2u windowSize) {
+    letterboxWindowSize = windowSize;
+    if (windowSize.x == 0 || windowSize.y == 0) return;  // minimized
+
+    Vector2f frame(offscreen.getSize());
+    float scale = min(windowSize.x / frame.x, windowSize.y / frame.y);
+    Vector2f shown(frame.x * scale, frame.y * scale);
+    Vector2f offset((windowSize.x - shown.x) / 2.f, (windowSize.y - shown.y) / 2.f);
+
+    letterboxView.reset(FloatRect(0, 0, frame.x, frame.y));
+    letterboxView.setViewport(FloatRect(offset.x / windowSize.x, offset.y / windowSize.y,
+        shown.x / windowSize.x, shown.y / windowSize.y));
+    Input::getInstance().setTargetArea(IntRect(static_cast<int>(offset.x), static_cast<int>(offset.y),
+        static_cast<int>(shown.x), static_cast<int>(shown.y)), offscreen.getSize());
+}
+
+// the game runs until the window closes, or until quit() when there is no window
+bool Game::isRunning() const {
+    return isHeadless() ? !quitRequested : window.isOpen();
+}
+
+// ends the main loop
+void Game::quit() {
+    quitRequested = true;
+    window.close();
+}
+
+// presents the frame the current scene just rendered
+void Game::present() {
+    FrameProfiler::getInstance().measureFontPages();  // every font drawn this frame is still alive here
+    switch (renderMode) {
+        case RenderMode::Window:
+            window.display();
+            break;
+        case RenderMode::Offscreen:
+            offscreen.display();
+            break;
+        case RenderMode::Letterbox: {
+            offscreen.display();
+            if (window.getSize() != letterboxWindowSize) {
+                updateLetterbox(window.getSize());  // resized while a modal screen had the window
+            }
+            window.setView(letterboxView);
+            window.clear(Color::Black);             // the bars
+            FrameProfiler::draw(window, Sprite(offscreen.getTexture()));
+            window.display();
+            // the modal screens draw straight into the window, laid out for its size
+            window.setView(View(FloatRect(0, 0, static_cast<float>(window.getSize().x), static_cast<float>(window.getSize().y))));
+            break;
+        }
+        case RenderMode::Null:
+            break;
     }
+    StartupReport::getInstance().finish();  // the first frame ends startup (writes startup.log once)
 }
 
-// loads saved progress from a file if available
-void Game::loadProgress() {
-    ifstream loadFile("savegame.txt");
-    int savedScene = 0;
-    int lionScore = 0, scarecrowScore = 0, tinmanScore = 0;
+// copies the frame being drawn into a texture, before present() (a window's back buffer is undefined after display)
+void Game::captureFrame(Texture& frame) {
+    switch (renderMode) {
+        case RenderMode::Window:
+            if (frame.getSize() != window.getSize() && !frame.create(window.getSize().x, window.getSize().y)) return;
+            frame.update(window);
+            break;
+        case RenderMode::Offscreen:
+        case RenderMode::Letterbox:
+            offscreen.display();  // resolves what was drawn so far into its texture
+            if (frame.getSize() != offscreen.getSize() && !frame.create(offscreen.getSize().x, offscreen.getSize().y)) return;
+            frame.update(offscreen.getTexture());
+            break;
+        case RenderMode::Null:
+            break;                // nothing is drawn, the crossfade draws nothing either
+    }
+}
 
-    if (loadFile.is_open()) {
-        loadFile >> savedScene;
-        loadFile >> lionScore;
-        loadFile >> scarecrowScore;
-        loadFile >> tinmanScore;
-        loadFile.close();
+// hands the player's progress to the save service, which writes it in the background
+void Game::saveProgress() {
+    GameScore& score = GameScore::getInstance();
+    SaveService::Snapshot snapshot;
+    snapshot.scene = static_cast<int>(currentScene);
+    snapshot.lion = score.getScore(GameScore::ScoreType::LION);
+    snapshot.scarecrow = score.getScore(GameScore::ScoreType::SCARECROW);
+    snapshot.tinman = score.getScore(GameScore::ScoreType::TINMAN);
+    snapshot.hasSceneState = getSceneSnapshot(snapshot.sceneState);
+    SaveService::getInstance().save(snapshot);
+}
 
-        GameScore& score = GameScore::getInstance();
-        score.setScore(GameScore::ScoreType::LION, lionScore);
-        score.setScore(GameScore::ScoreType::SCARECROW, scarecrowScore);
-        score.setScore(GameScore::ScoreType::TINMAN, tinmanScore);
+// the mid-chapter state of the scene being played, the menu and outro always start over
+bool Game::getSceneSnapshot(SceneSnapshot& snapshot) const {
+    switch (currentScene) {
+        case Scene::Intro: snapshot = introScene->getSnapshot(); return true;
+        case Scene::Lion: snapshot = lionScene->getSnapshot(); return true;
+        case Scene::Scarecrow: snapshot = scarecrowScene->getSnapshot(); return true;
+        case Scene::Tinman: snapshot = tinmanScene->getSnapshot(); return true;
+        default: return false;
+    }
+}
+
+void Game::restoreSceneSnapshot(const SceneSnapshot& snapshot) {
+    switch (currentScene) {
+        case Scene::Intro: introScene->restore(snapshot); break;
+        case Scene::Lion: lionScene->restore(snapshot); break;
+        case Scene::Scarecrow: scarecrowScene->restore(snapshot); break;
+        case Scene::Tinman: tinmanScene->restore(snapshot); break;
+        default: break;
+    }
+}
 
+// loads saved progress if there is a valid save
+void Game::loadProgress() {
+    SaveService::Snapshot snapshot;
+    if (SaveService::getInstance().load(snapshot)) {
+        GameScore& score = GameScore::getInstance();
+        score.setScore(GameScore::ScoreType::LION, snapshot.lion);
+        score.setScore(GameScore::ScoreType::SCARECROW, snapshot.scarecrow);
+        score.setScore(GameScore::ScoreType::TINMAN, snapshot.tinman);
     }
-    // in case saved scene is out of bounds (corrupted save or manual tampering)
+    // in case saved scene is out of bounds (manual tampering or a save from a newer build)
     // validate the loaded scene, fallback to intro if it's invalid
-    if (savedScene >= static_cast<int>(Scene::Menu) && savedScene <= static_cast<int>(Scene::Outro)) {
-        loadScene(static_cast<Scene>(savedScene));
+    if (snapshot.scene >= static_cast<int>(Scene::Menu) && snapshot.scene <= static_cast<int>(Scene::Outro)) {
+        loadScene(static_cast<Scene>(snapshot.scene));  // the chapter from its start, with its own score cleared
+        if (snapshot.hasSceneState) {
+            // then straight to where the player was, with the scores they had there
+            GameScore& score = GameScore::getInstance();
+            score.setScore(GameScore::ScoreType::LION, snapshot.lion);
+            score.setScore(GameScore::ScoreType::SCARECROW, snapshot.scarecrow);
+            score.setScore(GameScore::ScoreType::TINMAN, snapshot.tinman);
+            try {
+                restoreSceneSnapshot(snapshot.sceneState);
+            }
+            catch (const runtime_error&) {
+                // the save names questions this build doesn't have, the chapter start it is
+            }
+            saveProgress();
+        }
     }
     else {
         // save file not found, start a new game
-        currentScene = Scene::Intro;
+        enterScene(Scene::Intro);
         introScene->reset();
     }
 }
 
 // switch music based on scene
+// during a transition that fades the music out this waits: the transition switches it once the old music is silent
 void Game::updateSceneMusic() {
+    if (fadingMusic) return;
     stopMusic();  // stop any current music before switching
 
     switch (currentScene) {
@@ -144,7 +337,7 @@ void Game::pauseMusic() {
 
 // resume music if it was paused
 void Game::resumeMusic() {
-    if (window.isOpen()) {
+    if (isRunning()) {
         if (music.getStatus() == sf::Music::Paused) {
             music.play();
         }
@@ -153,6 +346,7 @@ void Game::resumeMusic() {
 
 // stop music currently playing
 void Game::stopMusic() {
+    Trace::Scope trace("Game::stopMusic", "blocking");  // the fade blocks the main thread
     if (music.getStatus() == sf::Music::Playing || music.getStatus() == sf::Music::Paused) {
         // fade out
         float currentVolume = music.getVolume();
@@ -162,15 +356,23 @@ void Game::stopMusic() {
         }
         music.stop();
         music.setVolume(currentVolume); // reset volume for future play
+        GameClock::getInstance().skipNextTick();  // the fade's wait isn't game time
     }
     music.setPlayingOffset(Time::Zero);
 }
 
+// stops the music at once, for transitions that have already faded it out
+void Game::cutMusic() {
+    music.stop();
+    music.setVolume(volume);  // reset volume for future play
+    music.setPlayingOffset(Time::Zero);
+}
+
 // loads a specific scene and resets it
 void Game::loadScene(Scene scene) {
     switch (scene) {
         case Scene::Intro:
-            currentScene = Scene::Intro;
+            enterScene(Scene::Intro);
             introScene->reset();
             break;
         case Scene::Lion:
@@ -184,99 +386,148 @@ void Game::loadScene(Scene scene) {
             break;
         case Scene::Outro:
             isFlatlinePlaying = false;
-            currentScene = Scene::Outro;
-            outroScene = make_unique<Outro>(window);
+            enterScene(Scene::Outro);
+            resetTraced("Outro", *outroScene);
             break;
         default:
-            currentScene = Scene::Intro;
+            enterScene(Scene::Intro);
             introScene->reset();
             break;
     }
 }
 
+// seconds a fade out, fade in or crossfade takes (game time)
+static const float fadeSeconds = 0.5f;
+
 // handles switching between scenes when certain conditions are met
+// the switches start a transition, which plays out over the next frames of the main loop
 void Game::switchScene() {
     if (currentScene == Scene::Menu && menuScene->isTextComplete()) {
         int selectedItem = menuScene->getPressedItem();
-        this_thread::sleep_for(chrono::milliseconds(500));
 
         if (selectedItem == 2) {  // display control screen
-            pauseMusic();  
-            ControlScreen controls(window);
-            controls.show();
-            resumeMusic();
-            resize();
-            menuScene->reset();
+            menuScene->reset();   // frozen under the fade, the choice mustn't be picked up again afterwards
+            if (!isHeadless()) {
+                transition.add(SceneTransition::Kind::FadeOut, fadeSeconds, [this] {
+                    pauseMusic();
+                    {
+                        MemoryTracker::OwnerScope owner("ControlScreen (menu)");
+                        ControlScreen controls(window);
+                        controls.show();
+                    }
+                    MemoryTracker::getInstance().releaseOwner("ControlScreen (menu)");  // the screen is gone again
+                    resumeMusic();
+                    resize();
+                    menuScene->reset();
+                    GameClock::getInstance().skipNextTick();  // the screen's time isn't the fade in's
+                });
+                transition.add(SceneTransition::Kind::FadeIn, fadeSeconds);
+            }
             return;
         }
-        updateSceneMusic();
 
         if (selectedItem == 0) {
-            // clear save file if starting a New Game
-            ofstream saveFile("savegame.txt", ofstream::trunc);
-            if (saveFile.is_open()) {
-                saveFile.close();  // empty the file
-            }
-            // start a new game
-            currentScene = Scene::Intro;
+            // start a new game, the fresh save replaces the old one atomically
+            startCrossfade();
+            enterScene(Scene::Intro);
             introScene->reset();
-            updateSceneMusic();
+            SaveService::Snapshot fresh;   // no scores, no chapter progress
+            fresh.scene = static_cast<int>(Scene::Intro);
+            SaveService::getInstance().save(fresh);
         }
         else if (selectedItem == 1) {  // load existing game progress
-            loadProgress();
-            updateSceneMusic();
+            startCrossfade();
+            loadProgress();  // the chapter's music starts when the crossfade ends
         }
         
         else {                         // any other option, exit game
             stopMusic();
-            window.close();
+            quit();
         }
     }
 
-    if (currentScene == Scene::Intro && introScene->isTextComplete()) {
-        if (Keyboard::isKeyPressed(Keyboard::Enter)) {
-            stopMusic();
-            this_thread::sleep_for(chrono::milliseconds(500));
-            chapterTitleScreens.showNextChapter("Chapter 1: The Lion");
-            currentScene = Scene::Lion;
-            lionScene->reset();
-            updateSceneMusic();  
-            saveProgress();
-        }
+    // the rest waits for the current chapter's ChapterCompleted, then for Enter
+    if (!chapterComplete || !Input::getInstance().isKeyPressed(Keyboard::Enter)) {
+        return;
     }
-
-    if (currentScene == Scene::Lion && lionScene->isTextComplete() && lionScene->areQuestionsComplete()) {
-        if (Keyboard::isKeyPressed(Keyboard::Enter)) {
-            stopMusic();
-            this_thread::sleep_for(chrono::milliseconds(500));
-            chapterTitleScreens.showNextChapter("Chapter 2: The Scarecrow");
-            currentScene = Scene::Scarecrow;
-            scarecrowScene->reset();
-            updateSceneMusic();  
+    switch (currentScene) {
+        case Scene::Intro:
+            startChapterTransition(Scene::Lion, "Chapter 1: The Lion");
+            break;
+        case Scene::Lion:
+            startChapterTransition(Scene::Scarecrow, "Chapter 2: The Scarecrow");
+            break;
+        case Scene::Scarecrow:
+            startChapterTransition(Scene::Tinman, "Chapter 3: The Tinman");
+            break;
+        case Scene::Tinman:
+            startCrossfade();
+            enterScene(Scene::Outro);
+            resetTraced("Outro", *outroScene);  // picks the ending for the final scores
             saveProgress();
-        }
+            break;
+        default:
+            break;
     }
+}
 
-    if (currentScene == Scene::Scarecrow && scarecrowScene->isTextComplete() && scarecrowScene->areQuestionsComplete()) {
-        if (Keyboard::isKeyPressed(Keyboard::Enter)) {
-            stopMusic();
-            this_thread::sleep_for(chrono::milliseconds(500));
-            chapterTitleScreens.showNextChapter("Chapter 3: The Tinman");
-            currentScene = Scene::Tinman;
-            tinmanScene->reset();
-            updateSceneMusic(); 
-            saveProgress();
+// the finished chapter fades to black with its music, the next one is switched to while the screen is black,
+// then its title card plays and it fades in. the frames keep coming throughout (input, jobs, loading underneath)
+void Game::startChapterTransition(Scene next, const string& title) {
+    const bool showCard = !isHeadless();  // nobody would see it, headless runs go straight on
+    fadingMusic = true;
+    transition.add(SceneTransition::Kind::FadeOut, fadeSeconds, [this, next, title, showCard] {
+        fadingMusic = false;
+        cutMusic();
+        enterScene(next);
+        resetScene(next);
+        saveProgress();
+        if (showCard) {
+            MemoryTracker::OwnerScope owner("ChapterTitleScreens");
+            chapterTitleScreens.begin(title);
+        }
+        else {
+            updateSceneMusic();
         }
+    });
+    if (showCard) {
+        transition.add(SceneTransition::Kind::TitleCard, ChapterTitleScreens::duration, [this] {
+            chapterTitleScreens.end();
+            updateSceneMusic();
+        });
     }
+    transition.add(SceneTransition::Kind::FadeIn, fadeSeconds);
+}
 
-    if (currentScene == Scene::Tinman && tinmanScene->isTextComplete() && tinmanScene->areQuestionsComplete() && tinmanScene->areRiddlesComplete()) {
-        if (Keyboard::isKeyPressed(Keyboard::Enter)) {
-            this_thread::sleep_for(chrono::milliseconds(500));
-            currentScene = Scene::Outro;
-            outroScene = make_unique<Outro>(window);
-            updateSceneMusic();  
-            saveProgress();
-        }
+// keeps the current scene's look for the crossfade, call it right before switching
+// the music fades out with the old scene's picture, the new scene's music starts when the crossfade ends
+void Game::startCrossfade() {
+    renderCurrentScene();
+    captureFrame(transition.getOutgoingFrame());
+    fadingMusic = true;
+    transition.add(SceneTransition::Kind::Crossfade, fadeSeconds, [this] {
+        fadingMusic = false;
+        cutMusic();
+        updateSceneMusic();
+    });
+}
+
+// every scene change goes through here, the new scene has to announce its own completion
+void Game::enterScene(Scene scene) {
+    currentScene = scene;
+    chapterComplete = false;
+    layoutScene(scene);  // it may still be laid out for the size before a resize
+}
+
+// restarts a scene in place, its resources stay loaded
+void Game::resetScene(Scene scene) {
+    switch (scene) {
+        case Scene::Menu: resetTraced("Menu", *menuScene); break;
+        case Scene::Intro: resetTraced("Intro", *introScene); break;
+        case Scene::Lion: resetTraced("Lion", *lionScene); break;
+        case Scene::Scarecrow: resetTraced("Scarecrow", *scarecrowScene); break;
+        case Scene::Tinman: resetTraced("Tinman", *tinmanScene); break;
+        case Scene::Outro: resetTraced("Outro", *outroScene); break;
     }
 }
 
@@ -284,15 +535,14 @@ void Game::switchScene() {
 void Game::resetGame() {
     // reset scores
     GameScore::getInstance().resetScore(GameScore::ScoreType::TOTALSCORE);
-    // recreate all scenes
-    menuScene = make_unique<Menu>(window);
-    introScene = make_unique<Intro>(window);
-    lionScene = make_unique<Lion>(window);
-    scarecrowScene = make_unique<Scarecrow>(window);
-    tinmanScene = make_unique<Tinman>(window);
-    outroScene = make_unique<Outro>(window);
+    // reset all scenes, they keep their textures, frames and fonts (the outro restarts when it is reached)
+    resetTraced("Menu", *menuScene);
+    resetTraced("Intro", *introScene);
+    resetTraced("Lion", *lionScene);
+    resetTraced("Scarecrow", *scarecrowScene);
+    resetTraced("Tinman", *tinmanScene);
     // set the current scene back Intro
-    currentScene = Scene::Intro;
+    enterScene(Scene::Intro);
     updateSceneMusic();
     saveProgress();
 }
@@ -300,11 +550,10 @@ void Game::resetGame() {
 // resets everything needed to restart from lion (score, scenes and set currentScene)
 void Game::loadLion() {
     GameScore::getInstance().resetScore(GameScore::ScoreType::TOTALSCORE);
-    lionScene = make_unique<Lion>(window);  
-    scarecrowScene = make_unique<Scarecrow>(window);
-    tinmanScene = make_unique<Tinman>(window);
-    outroScene = make_unique<Outro>(window);
-    currentScene = Scene::Lion;
+    resetTraced("Lion", *lionScene);
+    resetTraced("Scarecrow", *scarecrowScene);
+    resetTraced("Tinman", *tinmanScene);
+    enterScene(Scene::Lion);
     updateSceneMusic();
     saveProgress();
 }
@@ -313,10 +562,9 @@ void Game::loadLion() {
 void Game::loadScarecrow() {
     GameScore::getInstance().resetScore(GameScore::ScoreType::SCARECROW);
     GameScore::getInstance().resetScore(GameScore::ScoreType::TINMAN);
-    scarecrowScene = make_unique<Scarecrow>(window);
-    tinmanScene = make_unique<Tinman>(window);
-    outroScene = make_unique<Outro>(window);
-    currentScene = Scene::Scarecrow;
+    resetTraced("Scarecrow", *scarecrowScene);
+    resetTraced("Tinman", *tinmanScene);
+    enterScene(Scene::Scarecrow);
     updateSceneMusic();
     saveProgress();
 }
@@ -324,44 +572,113 @@ void Game::loadScarecrow() {
 // resets everything needed to restart from tinman
 void Game::loadTinman() {
     GameScore::getInstance().resetScore(GameScore::ScoreType::TINMAN);
-    tinmanScene = make_unique<Tinman>(window);
-    outroScene = make_unique<Outro>(window);
-    currentScene = Scene::Tinman;
+    resetTraced("Tinman", *tinmanScene);
+    enterScene(Scene::Tinman);
     updateSceneMusic();
     saveProgress();
 }
 
+// updates, draws and presents one scene, each step timed by the frame profiler
+template <typename SceneType>
+void Game::updateAndRenderScene(SceneType& scene) {
+    {
+        FrameProfiler::Scope profile(FrameProfiler::Section::Update);
+        scene.update();
+    }
+    {
+        FrameProfiler::Scope profile(FrameProfiler::Section::Render);
+        scene.render();
+        FrameProfiler::getInstance().drawOverlay(target);  // only draws when toggled on (F3)
+    }
+    FrameProfiler::Scope profile(FrameProfiler::Section::Display);
+    present();
+}
+
+// updates the active scene
+void Game::updateCurrentScene() {
+    switch (currentScene) {
+        case Scene::Menu: menuScene->update(); break;
+        case Scene::Intro: introScene->update(); break;
+        case Scene::Lion: lionScene->update(); break;
+        case Scene::Scarecrow: scarecrowScene->update(); break;
+        case Scene::Tinman: tinmanScene->update(); break;
+        case Scene::Outro: outroScene->update(); break;
+    }
+}
+
+// draws the active scene into target
+void Game::renderCurrentScene() {
+    switch (currentScene) {
+        case Scene::Menu: menuScene->render(); break;
+        case Scene::Intro: introScene->render(); break;
+        case Scene::Lion: lionScene->render(); break;
+        case Scene::Scarecrow: scarecrowScene->render(); break;
+        case Scene::Tinman: tinmanScene->render(); break;
+        case Scene::Outro: outroScene->render(); break;
+    }
+}
+
+// one frame of the running transition: a fade out shows the outgoing scene standing still, the title card
+// covers everything, a fade in or crossfade runs the incoming scene as usual. the step's overlay goes on top
+void Game::updateAndRenderTransition() {
+    transition.update(GameClock::getInstance().getDeltaTime());  // an ending step may switch the scene
+    if (!transition.isActive()) {
+        updateAndRender();  // over, this frame is an ordinary one
+        return;
+    }
+
+    const SceneTransition::Kind kind = transition.getKind();
+    if (kind == SceneTransition::Kind::FadeIn || kind == SceneTransition::Kind::Crossfade) {
+        FrameProfiler::Scope profile(FrameProfiler::Section::Update);
+        updateCurrentScene();
+    }
+    if ((kind == SceneTransition::Kind::FadeOut || kind == SceneTransition::Kind::Crossfade) && fadingMusic) {
+        music.setVolume(volume * (1.0f - transition.getProgress()));
+    }
+    {
+        FrameProfiler::Scope profile(FrameProfiler::Section::Render);
+        if (kind == SceneTransition::Kind::TitleCard) {
+            chapterTitleScreens.draw(transition.getElapsed());
+        }
+        else {
+            renderCurrentScene();
+            transition.drawOverlay(target);
+        }
+        FrameProfiler::getInstance().drawOverlay(target);  // only draws when toggled on (F3)
+    }
+    FrameProfiler::Scope profile(FrameProfiler::Section::Display);
+    present();
+}
+
 // updates and draws the active scene
 void Game::updateAndRender() {
+    if (transition.isActive()) {
+        updateAndRenderTransition();
+        return;
+    }
     switch (currentScene) {
         case Scene::Menu:
-            menuScene->update();
-            menuScene->render();
+            updateAndRenderScene(*menuScene);
             switchScene();
             break;
         case Scene::Intro:
-            introScene->update();
-            introScene->render();
+            updateAndRenderScene(*introScene);
             switchScene();
             break;
         case Scene::Lion:
-            lionScene->update();
-            lionScene->render();
+            updateAndRenderScene(*lionScene);
             switchScene();
             break;
         case Scene::Scarecrow:
-            scarecrowScene->update();
-            scarecrowScene->render();
+            updateAndRenderScene(*scarecrowScene);
             switchScene();
             break;
         case Scene::Tinman:
-            tinmanScene->update();
-            tinmanScene->render();
+            updateAndRenderScene(*tinmanScene);
             switchScene();
             break;
         case Scene::Outro:
-            outroScene->update();
-            outroScene->render();
+            updateAndRenderScene(*outroScene);
 
             // special case that allows flatline to play without conflict
             if (outroScene->isPlayingGif()) {
@@ -377,14 +694,19 @@ void Game::updateAndRender() {
 
 // displays and handles the pause menu choices
 void Game::handlePauseMenu() {
+    if (pauseMenuLayoutSize != window.getSize()) {
+        pauseMenu->resize();  // the window changed size since the menu was last up
+        pauseMenuLayoutSize = window.getSize();
+    }
     PauseMenuChoice choice = pauseMenu->show();
+    pauseMenuLayoutSize = window.getSize();  // show() follows resizes while it is up
     switch (choice) {
         case PauseMenuChoice::Resume:   
             isPaused = false;  
             resize();
             break;
         case PauseMenuChoice::MainMenu:
-            currentScene = Scene::Menu;  
+            enterScene(Scene::Menu);  
             updateSceneMusic();
             menuScene->reset();
             isPaused = false;  
@@ -394,38 +716,53 @@ void Game::handlePauseMenu() {
             break;
         case PauseMenuChoice::Quit:
             stopMusic();
-            window.close();              
+            quit();              
             break;
     }
 }
 
 // processes window events like closing, resizing, and keypresses
 void Game::handleEvents() {
+    FrameProfiler::Scope profile(FrameProfiler::Section::Events);
     Event event;
-    while (window.pollEvent(event)) {
+    bool resizedThisTick = false;
+    while (Input::getInstance().pollEvent(event)) {
         if (event.type == Event::Closed) {
+            if (currentScene != Scene::Menu) saveProgress();  // resume right here next time
             stopMusic();
-            window.close(); 
+            quit(); 
         }
         if (event.type == Event::Resized) {
-            FloatRect visibleArea(0, 0, event.size.width, event.size.height);
-            window.setView(View(visibleArea));
-            resize();
+            handleResizeEvent(event);
+            resizedThisTick = true;
         }
         if (event.type == Event::KeyPressed) {
+            if (transition.isActive() && transition.getKind() == SceneTransition::Kind::TitleCard) {
+                transition.skip();  // any key skips the title card
+            }
             switch (event.key.code) {
                 case Keyboard::Escape:
                 case Keyboard::Space:
-                    if (currentScene != Scene::Menu) {   
+                    if (currentScene != Scene::Menu && !transition.isActive()) {   // the transition owns the screen until it is done
                         isPaused = !isPaused;
-                        this_thread::sleep_for(chrono::milliseconds(300));
+                        sleepTraced(chrono::milliseconds(300));
                     }
                     break;
+                case Keyboard::F3:
+                    FrameProfiler::getInstance().toggleOverlay();  // frame time / counters overlay
+                    break;
+                case Keyboard::F4:
+                    MemoryTracker::getInstance().writeDump("memory.log");  // texture / audio memory per owner and type
+                    break;
                 case Keyboard::C: {
-                    if (currentScene != Scene::Menu) {
+                    if (currentScene != Scene::Menu && !transition.isActive()) {
                         pauseMusic();  
-                        ControlScreen controls(window);
-                        controls.show();
+                        {
+                            MemoryTracker::OwnerScope owner("ControlScreen (C)");
+                            ControlScreen controls(window);
+                            controls.show();
+                        }
+                        MemoryTracker::getInstance().releaseOwner("ControlScreen (C)");  // the screen is gone again
                         resumeMusic();
                         resize();
                     }
@@ -436,13 +773,54 @@ void Game::handleEvents() {
                 }
         }
     }
+    applySettledResize(resizedThisTick);
+}
+
+// a Resized event only records the size, the view keeps the old one meanwhile (the frame is stretched to the window)
+void Game::handleResizeEvent(const Event& event) {
+    if (renderMode == RenderMode::Letterbox) {
+        updateLetterbox(Vector2u(event.size.width, event.size.height));  // only the view changes, the frame keeps its layout
+        return;
+    }
+    resizePending = true;
+    pendingSize = Vector2u(event.size.width, event.size.height);
+    resizeSettleTime = 0.0f;
+}
+
+// the drag is over once no Resized event came for a short while, then the view and the visible scene follow
+void Game::applySettledResize(bool resizedThisTick) {
+    static const float settleSeconds = 0.15f;
+    if (!resizePending || resizedThisTick) return;
+
+    resizeSettleTime += Input::getInstance().getDeltaTime();
+    if (resizeSettleTime < settleSeconds) return;
+
+    resizePending = false;
+    window.setView(View(FloatRect(0, 0, static_cast<float>(pendingSize.x), static_cast<float>(pendingSize.y))));
+    resize();
 }
 
 // shows the retry screen and acts on the user's choice
 void Game::handleRetry() {
     isFlatlinePlaying = false;
-    RetryScreen retryScreen(window);
-    RetryResult result = retryScreen.show();
+    if (isHeadless()) {
+        quit();   // nobody to ask, a headless run ends with the outro
+        return;
+    }
+    showRetryScreens();
+    MemoryTracker::getInstance().releaseOwner("RetryScreen (retry)");  // the screens are gone again
+    MemoryTracker::getInstance().releaseOwner("LoadScreen (retry)");
+}
+
+// the retry screen (and the load screen behind it) until the player picks something, then acts on it
+// the screens are built for this one showing, their fonts and textures under their own owners
+void Game::showRetryScreens() {
+    unique_ptr<RetryScreen> retry;
+    {
+        MemoryTracker::OwnerScope owner("RetryScreen (retry)");
+        retry = make_unique<RetryScreen>(window);
+    }
+    RetryResult result = retry->show();
 
     while (true) {
         if (result == RetryResult::Restart) {
@@ -451,19 +829,23 @@ void Game::handleRetry() {
         }
         if (result == RetryResult::Quit) {
             stopMusic();
-            window.close();
+            quit();
             return;
         }
         if (result == RetryResult::Load) {
-            LoadScreen loadScreen(window);
-            LoadChoice loadChoice = loadScreen.show();
+            LoadChoice loadChoice;
+            {
+                MemoryTracker::OwnerScope owner("LoadScreen (retry)");
+                LoadScreen load(window);
+                loadChoice = load.show();  // shown under the owner too: nothing else loads while it is up
+            }
 
             if (!window.isOpen()) {
                 return; // window was closed (ESC or X)
             }
 
             if (loadChoice == LoadChoice::Back) {
-                result = retryScreen.show();
+                result = retry->show();
                 continue;
             }
 
@@ -480,58 +862,84 @@ void Game::handleRetry() {
 
 void Game::run() {
     // main game loop
-    while (window.isOpen()) {
-        handleEvents();  // process input and system events
-        // check if paused then handle pause menu
-        if (isPaused) {
-            pauseMusic();
-            handlePauseMenu();
-            resumeMusic();        
-        }
-        else {
-            updateAndRender();  
-        }
-        // check for outro completion and show retry option
-        if (currentScene == Scene::Outro && outroScene->outroFinished) {
-            stopMusic();
-            handleRetry();
-        }
+    while (isRunning()) {
+        step();
 
+        FrameProfiler::Scope profile(FrameProfiler::Section::Sleep);
         // dynamically adjust framerate: no delay when holding Right arrow (fast-forwarding),
         // short delay otherwise to limit CPU usage
-        if (Keyboard::isKeyPressed(Keyboard::Right)) {
+        if (Input::getInstance().isKeyPressed(Keyboard::Right)) {
             this_thread::sleep_for(chrono::milliseconds(0));
         }
         else {
-            this_thread::sleep_for(chrono::milliseconds(30));
+            // spend the idle part of the frame helping the job system before sleeping
+            auto frameEnd = chrono::steady_clock::now() + chrono::milliseconds(30);
+            JobSystem::getInstance().runUntilIdle(chrono::milliseconds(30));
+            this_thread::sleep_until(frameEnd);
         }
     }
 }
 
-// resize and reposition all UI and scenes to match current window dimensions
+// one tick of the game: input, events, update/render and the end-of-game check
+void Game::step() {
+    FrameProfiler::getInstance().beginFrame();
+    Input::getInstance().beginFrame(); // snapshot input and delta time for this tick
+    if (Input::getInstance().isReplayFinished()) {
+        quit();      // the recorded session is over
+        return;
+    }
+    GameClock::getInstance().tick(Input::getInstance().getDeltaTime()); // game time for this tick, every timed system reads it
+    handleEvents();  // process input and system events
+    // check if paused then handle pause menu
+    if (isPaused) {
+        GameClock& clock = GameClock::getInstance();
+        clock.setPaused(true);  // game time (the riddle countdown, animations) stands still while the menu is up
+        saveProgress();     // the player may quit from here, keep the exact spot
+        pauseMusic();
+        handlePauseMenu();
+        resumeMusic();        
+        clock.setPaused(isPaused);
+        clock.skipNextTick();   // the next frame's delta is the time the menu was up
+    }
+    else {
+        updateAndRender();  
+    }
+    // check for outro completion and show retry option
+    if (currentScene == Scene::Outro && outroScene->outroFinished) {
+        stopMusic();
+        handleRetry();
+    }
+}
+
+// the question handler the current scene is showing, so scripted runs can find the buttons
+QuestionHandler* Game::getActiveQuestions() {
+    switch (currentScene) {
+        case Scene::Lion: return lionScene->getActiveQuestions();
+        case Scene::Scarecrow: return scarecrowScene->getActiveQuestions();
+        case Scene::Tinman: return tinmanScene->getActiveQuestions();
+        default: return nullptr;
+    }
+}
+
+// resize and reposition the UI and scene on screen to match current window dimensions
+// the pause menu is laid out when it is opened, the retry, control and load screens lay themselves out when shown
 void Game::resize() {
-    pauseMenu->resize();
-    retryScreen->resize();
-    controlScreen->resize();
-    loadScreen->resize();
-    menuScene->resize();
-    introScene->resize();
-    lionScene->resize();
-    scarecrowScene->resize();
-    tinmanScene->resize(); 
-    outroScene->resize();
-}
-
-// create game instance and start main loop (for Release)
-//int WinMain() {
-//    Game game;
-//    game.run();
-//    return 0;
-//}
-
-// create game instance and start main loop (for Debug with terminal)
-int main() {
-    Game game;
-    game.run();
-    return 0;
-}
\ No newline at end of file
+    layoutScene(currentScene);
+}
+
+// relays out a scene if the target changed size since its last layout, a stale scene pays for it once, when it is entered
+void Game::layoutScene(Scene scene) {
+    Vector2u& laidOutFor = sceneLayoutSize[static_cast<size_t>(scene)];
+    if (laidOutFor == target.getSize()) return;  // also what makes resizing back and forth free for the hidden scenes
+
+    Trace::Scope trace("Game::layoutScene", "resize");
+    switch (scene) {
+        case Scene::Menu: menuScene->resize(); break;
+        case Scene::Intro: introScene->resize(); break;
+        case Scene::Lion: lionScene->resize(); break;
+        case Scene::Scarecrow: scarecrowScene->resize(); break;
+        case Scene::Tinman: tinmanScene->resize(); break;
+        case Scene::Outro: outroScene->resize(); break;
+    }
+    laidOutFor = target.getSize();
+}
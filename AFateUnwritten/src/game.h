@@ -4,6 +4,7 @@
 // core SFML modules
 #include <SFML/Graphics.hpp>
 #include <SFML/Audio.hpp>
+#include <array>
 
 // project includes
 #include "Scene.h"
@@ -14,9 +15,12 @@
 #include "Tinman.h"
 #include "Outro.h"
 #include "GameScore.h"
+#include "NullRenderTarget.h"
+#include "EventBus.h"
 
 // UI and utility headers
 #include "ChapterTitleScreens.h"
+#include "SceneTransition.h"
 #include "PauseMenu.h"
 #include "ControlScreen.h"
 #include "RetryScreen.h"
@@ -24,15 +28,41 @@
 
 class Game {
 public:
-    Game();     // constructor: sets up the game window and initial state
-    void run(); // main game loop
-private:
-    sf::RenderWindow window;                     // main SFML window for rendering the game
-    ChapterTitleScreens chapterTitleScreens;     // handles display of chapter title screens
+    // where frames go: a real window, an offscreen texture (headless) or nowhere at all (no GPU work)
+    // Letterbox renders into a fixed-size offscreen frame that is shown scaled in the window, resizing only moves the view
+    enum class RenderMode { Window, Offscreen, Null, Letterbox };
 
     // -- enumeration of all possible game scenes -- 
     enum class Scene { Menu, Intro, Lion, Scarecrow, Tinman, Outro };
+
+    explicit Game(RenderMode mode = RenderMode::Window); // constructor: sets up the render target and initial state
+    ~Game();                                     // stops listening for chapter events
+    void run(); // main game loop
+    void step(); // a single iteration of the main loop without frame pacing (run() calls this)
+    bool isRunning() const;                      // true until the window is closed or quit() is called
+
+    // -- automation (scripted playthroughs and benchmarks look at the game through these) --
+    Scene getCurrentScene() const { return currentScene; }
+    sf::FloatRect getMenuItemBounds(int index) const { return menuScene->getItemBounds(index); } // clickable area of a main menu entry
+    QuestionHandler* getActiveQuestions();       // quiz or riddles on screen right now (nullptr if none)
+    bool isOutroPlayingGif() const { return outroScene->isPlayingGif(); } // bad ending animation is running
+    bool isRiddleTimerRunning() const { return currentScene == Scene::Tinman && tinmanScene->areRiddlesActive(); } // Tinman's timed riddles are up
+private:
+    RenderMode renderMode;                       // how this game presents its frames
+    sf::RenderWindow window;                     // main SFML window (only opened in Window mode, modal screens use it)
+    sf::RenderTexture offscreen;                 // offscreen target for headless runs (and the letterbox frame)
+    sf::View letterboxView;                      // shows the letterbox frame in the window
+    sf::Vector2u letterboxWindowSize;            // window size letterboxView was fitted to
+    NullRenderTarget nullTarget;                 // target that accepts draws but skips all GPU work
+    sf::RenderTarget& target;                    // what the scenes draw into (one of the three above)
+    bool quitRequested = false;                  // ends the loop when there is no window to close
+    ChapterTitleScreens chapterTitleScreens;     // handles display of chapter title screens (the TitleCard step)
+    SceneTransition transition;                  // fade, title card or crossfade between scenes, if one is running
+    bool fadingMusic = false;                    // the running fade out or crossfade takes the music down with it
+
     Scene currentScene;                          // currently active scene
+    bool chapterComplete = false;                // the current chapter published ChapterCompleted, Enter moves on
+    EventBus::SubscriptionId chapterCompleted = 0;
 
     // -- smart pointers to each scene instance -- 
     std::unique_ptr<Menu> menuScene;              // Menu scene
@@ -44,25 +74,57 @@ private:
 
     // -- core game systems -- 
     std::unique_ptr<PauseMenu> pauseMenu;         // pause menu 
-    std::unique_ptr<ControlScreen> controlScreen; // control screen (shows controls/instructions)
-    std::unique_ptr<RetryScreen> retryScreen;     // retry screen (shown when player fails and retries)
-    std::unique_ptr<LoadScreen> loadScreen;       // loading screen (shown when loading scenes)
+    // the control, retry and load screens are rare, they are built when shown (under their own memory owner)
     bool isPaused = false;                        // tracks if game is currently paused
 
+    // -- resize pipeline --
+    // a window drag sends a stream of Resized events: they are coalesced, and once the size has settled
+    // only the visible scene is laid out. the others keep the size they were laid out for and catch up when entered
+    bool resizePending = false;                   // Resized events arrived, waiting for the size to settle
+    sf::Vector2u pendingSize;                     // size of the last of them
+    float resizeSettleTime = 0.0f;                // seconds since the last of them
+    std::array<sf::Vector2u, 6> sceneLayoutSize;  // per Scene: target size it was last laid out for
+    sf::Vector2u pauseMenuLayoutSize;             // window size the pause menu was last laid out for
+
+    // -- render target management --
+    sf::RenderTarget& initTarget();               // creates the window/offscreen texture for renderMode
+    bool isHeadless() const { return renderMode == RenderMode::Offscreen || renderMode == RenderMode::Null; }
+    void openWindow();                            // creates the game window (Window and Letterbox)
+    static sf::Vector2u getLetterboxFrameSize();  // size the letterbox frame is laid out and rendered at
+    void updateLetterbox(sf::Vector2u windowSize); // fits the frame into the window (view and mouse mapping)
+    void quit();                                  // stops the main loop (and closes the window if there is one)
+    void present();                               // shows the finished frame (display() on the active target)
+    void captureFrame(sf::Texture& frame);        // copies what target holds right now (before present) into frame
+
     // -- scene and window management -- 
     void switchScene();                           // switch between scenes when needed
-    void resize();                                // adjust UI and game objects to match new window size
+    void enterScene(Scene scene);                 // makes scene current (its chapter isn't complete yet)
+    void resetScene(Scene scene);                 // restarts a scene in place (traced)
+    void startChapterTransition(Scene next, const std::string& title); // fade out, title card (skipped when headless), fade in
+    void startCrossfade();                        // captures the current scene's frame, the next scene dissolves in over it
+    void resize();                                // lays out the visible scene for the current size (the others catch up when entered)
+    void layoutScene(Scene scene);                // relays out one scene, unless it already has the current size
+    void handleResizeEvent(const sf::Event& event); // remembers the new size, nothing is laid out yet
+    void applySettledResize(bool resizedThisTick);  // lays out once the Resized events have stopped for a moment
     void handlePauseMenu();                       // handle input and logic when the game is paused
     void handleEvents();                          // poll and process window events (input, window close, etc.)
     void updateAndRender();                       // update game state and render the current frame
+    template <typename SceneType>
+    void updateAndRenderScene(SceneType& scene);  // update, render (+ profiler overlay) and present one scene
+    void updateCurrentScene();                    // scene update only
+    void renderCurrentScene();                    // scene render only (no overlay, no present)
+    void updateAndRenderTransition();             // a frame of the running transition, the scene under it as the step needs
     void handleRetry();                           // handle retry logic when player fails (e.g., Tinman or Lion scene)
+    void showRetryScreens();                      // the retry (and load) screens and the choice made on them
 
     // -- game progress persistence -- 
     void loadProgress();                          // load saved game state from storage
     void loadScene(Scene scene);                  // load a specific scene based on saved or selected state
 
     // -- game state management -- 
-    void saveProgress();  // save the current game state to storage
+    void saveProgress();  // save the current game state to storage (written in the background by SaveService)
+    bool getSceneSnapshot(SceneSnapshot& snapshot) const; // where the current chapter scene is (false outside them)
+    void restoreSceneSnapshot(const SceneSnapshot& snapshot); // puts the current (freshly loaded) scene back there
     void resetGame();     // reset the game progress and state
 
     // -- scene-specific loading helpers -- 
@@ -74,11 +136,12 @@ private:
     sf::Music music;                              // music player for background music
     std::string filepath;                         // filepath of the currently loaded music
     float volume;                                 // volume level of the music
-    void updateSceneMusic();                      // update and play music based on current scene
+    void updateSceneMusic();                      // update and play music based on current scene (left to a fading transition)
     void playMusic(std::string filePath, float volume); // play music from file with specified volume
     void pauseMusic();                            // pause currently playing music
     void resumeMusic();                           // resume paused music
-    void stopMusic();                             // stop music completely
+    void stopMusic();                             // stop music completely (fades it out, blocking)
+    void cutMusic();                              // stop music at once (a transition has already faded it)
 
     // -- outro-specific variables for music handling --
     GameScore& gameScore = GameScore::getInstance(); // singleton reference to manage scores
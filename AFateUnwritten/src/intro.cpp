@@ -1,26 +1,41 @@
 #include "Intro.h"
 #include "IntroNarrative.h"
+#include "GameEvents.h"
 
 using namespace std;
 using namespace sf;
 
 // constructor: initialize Intro scene, load resources, and set up resizing
-Intro::Intro(RenderWindow& window) : Scene(window) {
+Intro::Intro(RenderTarget& window) : Scene(window) {
     loadResources(); 
     resize();       
+
+    dialogueFinished = EventBus::getInstance().subscribe<DialogueFinished>([this](const DialogueFinished& event) {
+        if (event.dialogue == introDialogue.get()) {
+            EventBus::getInstance().publish(ChapterCompleted{ Chapter::Intro });
+        }
+    });
+}
+
+// destructor: the bus outlives the scene
+Intro::~Intro() {
+    EventBus::getInstance().unsubscribe<DialogueFinished>(dialogueFinished);
 }
 
 // load background and dialogue lines for the intro
 void Intro::loadResources() {
     bgManager.setDefault("resources/images/castle_before.png"); 
-    auto start = IntroNarrative::getStartNarrative();           
-    introDialogues.assign(start.begin(), start.end());
+    introDialogues = IntroNarrative::getStartNarrative();
     loadCurrentDialogue();                                     
 }
 
 // load the current dialogue line into the dialogue system
 void Intro::loadCurrentDialogue() {
     const auto& line = introDialogues[currentDialogueIndex];
+    if (introDialogue) {
+        introDialogue->setLine(line);  // reuse the dialogue box, no font reload
+        return;
+    }
     introDialogue = make_unique<Dialogue>(window, line.speaker, line.text);
 }
 
@@ -29,7 +44,6 @@ void Intro::render() {
     window.clear();         
     bgManager.draw(window); 
     introDialogue->render(); 
-    window.display();       
 }
 
 // update the dialogue (for typing effect, speaker change, etc.)
@@ -39,9 +53,23 @@ void Intro::update() {
 
 // reset the scene back to the beginning of the intro
 void Intro::reset() {
-    introDialogue->reset();  
     currentDialogueIndex = 0; 
-    loadCurrentDialogue();    
+    loadCurrentDialogue();    // restarts the dialogue box on the first line
+}
+
+// records the line and how far it has been typed
+SceneSnapshot Intro::getSnapshot() const {
+    SceneSnapshot snapshot;
+    snapshot.dialogueIndex = static_cast<uint32_t>(currentDialogueIndex);
+    snapshot.typing = introDialogue->getTypingState();
+    return snapshot;
+}
+
+// continues the line from a save
+void Intro::restore(const SceneSnapshot& snapshot) {
+    currentDialogueIndex = min<size_t>(snapshot.dialogueIndex, introDialogues.size() - 1);
+    loadCurrentDialogue();
+    introDialogue->setTypingState(snapshot.typing);
 }
 
 // check if the current dialogue text has finished displaying
@@ -8,13 +8,16 @@
 // project includes
 #include "Scene.h"
 #include "Dialogue.h"
+#include "NarrativeStore.h"
 #include "BackgroundManager.h"
+#include "EventBus.h"
 
 // handles: intro scene logic, dialogue flow, background management
 class Intro : public Scene<Intro> {
 public:
     // -- constructor --
-    explicit Intro(sf::RenderWindow& window);  // sets up the intro scene with the game window
+    explicit Intro(sf::RenderTarget& window);  // sets up the intro scene with the game window
+    ~Intro();                              // stops listening for the dialogue
 
     // -- core functionality --
     void loadResources() override;         // loads textures, dialogue data, and other assets
@@ -26,6 +29,10 @@ public:
     // -- responsive UI support --
     void resize();                         // adjusts layout on window size change
 
+    // -- save and resume --
+    SceneSnapshot getSnapshot() const;     // where the intro is, for a save
+    void restore(const SceneSnapshot& snapshot); // picks up there, on a freshly reset scene
+
 private:
     // -- background rendering --
     sf::Texture bgTexture;                 // background texture
@@ -33,9 +40,10 @@ private:
     BackgroundManager bgManager;           // handles background transitions
 
     // -- dialogue flow --
-    std::vector<Dialogue::DialogueLine> introDialogues; // stores intro dialogue lines
+    NarrativeStore::Sequence introDialogues; // stores intro dialogue lines
     size_t currentDialogueIndex = 0;                    // tracks current dialogue position
     std::unique_ptr<Dialogue> introDialogue;            // handles active dialogue rendering
+    EventBus::SubscriptionId dialogueFinished = 0;      // the intro is over once its (single) line is
 
     // -- dialogue management --
     void loadCurrentDialogue();            // loads and prepares the current dialogue line
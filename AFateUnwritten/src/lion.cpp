@@ -1,11 +1,14 @@
 #include "Lion.h"
 #include "LionNarrative.h"
+#include "Input.h"
+#include "EventBus.h"
+#include "GameEvents.h"
 
 using namespace std;
 using namespace sf;
 
 // constructor: initialize Lion scene, load resources, prepare questions, and resize elements
-Lion::Lion(RenderWindow& window) : Scene(window), finalScore(0) { 
+Lion::Lion(RenderTarget& window) : Scene(window), finalScore(0) { 
     loadResources();
     initializeQuestions();
     resize();
@@ -15,8 +18,8 @@ Lion::Lion(RenderWindow& window) : Scene(window), finalScore(0) {
 void Lion::loadResources() {
     bgManager.setDefault("resources/images/lion_sad.png");
     LionNarrative::getBackgroundTriggers(bgManager);
-    auto start = LionNarrative::getStartNarrative();
-    lionDialogues.assign(start.begin(), start.end());
+    bgManager.prefetch();   // decode the trigger backgrounds in the background
+    lionDialogues = LionNarrative::getStartNarrative();
     loadCurrentDialogue();
 }
 
@@ -27,10 +30,14 @@ void Lion::loadCurrentDialogue() {
     }
 
     const auto& line = lionDialogues[currentDialogueIndex];
+    if (lionDialogue) {
+        lionDialogue->setLine(line);  // the dialogue box and its triggers stay, only the line changes
+        return;
+    }
     lionDialogue = make_unique<Dialogue>(window, line.speaker, line.text);
 
     // set up background change triggers based on special keywords
-    lionDialogue->setBackgroundChanges(bgManager.getTriggerMap());
+    lionDialogue->setBackgroundTriggers(LionNarrative::getTriggerAutomaton());
     lionDialogue->setBackgroundChangeCallback([&](const string& key) {
         bgManager(key); 
     });
@@ -60,10 +67,9 @@ void Lion::update() {
 
         // handle quiz questions
         case CurrentState::QuizActive:
-            questionHandler->update();
-            gameScore.setScore(GameScore::LION, questionHandler->getScore());
-            finalScore = gameScore.getScore(GameScore::LION);
+            questionHandler->update();  // GameScore hears about every answer from the handler
             if (questionHandler->isComplete()) {
+                finalScore = questionHandler->getScore();
                 // quiz failed: show retry dialogue
                 if (!gameScore.Condition(GameScore::LION)) {
                     currentDialogueIndex = 0;
@@ -100,7 +106,7 @@ void Lion::update() {
 
         case CurrentState::ShowingResults:
             // wait for Enter key to move to post-quiz dialogue
-            if (Keyboard::isKeyPressed(Keyboard::Enter) && !enterPressed) {
+            if (Input::getInstance().isKeyPressed(Keyboard::Enter) && !enterPressed) {
                 enterPressed = true;
                 currentState = CurrentState::PostQuizDialogue;
                 loadCurrentDialogue();
@@ -117,13 +123,16 @@ void Lion::update() {
                     if (currentDialogueIndex < lionDialogues.size()) {
                         loadCurrentDialogue();
                     }
+                    else if (currentDialogueIndex == lionDialogues.size()) {
+                        EventBus::getInstance().publish(ChapterCompleted{ Chapter::Lion });  // Game moves on with Enter
+                    }
                 }
             }
             break;
     }
 
     // track Enter key release to prevent skipping multiple states at once
-    if (!Keyboard::isKeyPressed(Keyboard::Enter)) {
+    if (!Input::getInstance().isKeyPressed(Keyboard::Enter)) {
         enterPressed = false;
     }
 }
@@ -131,19 +140,14 @@ void Lion::update() {
 // reset the Lion scene to its initial state
 void Lion::reset() {
     bgManager.setDefault("resources/images/lion_sad.png");
-    if (lionDialogue) {
-        lionDialogue->reset();
-    }
 
     currentDialogueIndex = 0;
     finalScore = 0;
     enterPressed = false;
     currentState = CurrentState::PreQuizDialogue;
 
-    lionDialogues.clear();
-    auto start = LionNarrative::getStartNarrative();
-    lionDialogues.assign(start.begin(), start.end());
-    loadCurrentDialogue();
+    lionDialogues = LionNarrative::getStartNarrative();
+    loadCurrentDialogue();  // restarts the dialogue box on the first line
 
     if (questionHandler) {
         questionHandler->reset();
@@ -169,8 +173,6 @@ void Lion::render() {
         }
         break;
     }
-
-    window.display();
 }
 
 // check if current dialogue text is fully typed and finished
@@ -192,13 +194,51 @@ void Lion::resize() {
 
 // initialize Lion-specific questions and configure question handler
 void Lion::initializeQuestions() {
-    lionQuestions = LionNarrative::getLionQuestions();
     questionHandler = make_unique<QuestionHandler>(window);
-    questionHandler->setQuestions(lionQuestions);
+    questionHandler->setQuestions(LionNarrative::getLionQuestions());
     questionHandler->setButtonColor(LevelType::Lion); 
+    questionHandler->setScoreType(GameScore::LION);
 }
 
 // check if the player has completed all quiz questions
 bool Lion::areQuestionsComplete() const {
     return questionHandler && questionHandler->isComplete();
 }
+
+// records the state machine, the line being typed, the quiz and the background
+SceneSnapshot Lion::getSnapshot() const {
+    SceneSnapshot snapshot;
+    snapshot.state = static_cast<int32_t>(currentState);
+    snapshot.dialogueIndex = static_cast<uint32_t>(currentDialogueIndex);
+    if (lionDialogue) snapshot.typing = lionDialogue->getTypingState();
+    snapshot.quiz = questionHandler->getQuizState();
+    snapshot.scores[0] = finalScore;
+    snapshot.backgroundKey = bgManager.getCurrentKey();
+    return snapshot;
+}
+
+// resumes a save: the state picks its sequence again, then the line, quiz and background are put back
+void Lion::restore(const SceneSnapshot& snapshot) {
+    if (snapshot.state < 0 || snapshot.state > static_cast<int32_t>(CurrentState::PostQuizDialogue)) return;
+    currentState = static_cast<CurrentState>(snapshot.state);
+    if (currentState == CurrentState::RetryDialogue) {
+        lionDialogues = LionNarrative::getRetryNarrative();
+    }
+    else if (currentState == CurrentState::ShowingResults || currentState == CurrentState::PostQuizDialogue) {
+        lionDialogues = LionNarrative::getGoodEndNarrative();
+    }
+    currentDialogueIndex = min<size_t>(snapshot.dialogueIndex, lionDialogues.size() - 1);
+    finalScore = snapshot.scores[0];
+    bgManager.restoreKey(snapshot.backgroundKey);
+    questionHandler->setQuizState(snapshot.quiz);
+
+    if (currentState != CurrentState::QuizActive && currentState != CurrentState::ShowingResults) {
+        loadCurrentDialogue();
+        lionDialogue->setTypingState(snapshot.typing);
+    }
+}
+
+// the quiz handler while the quiz is being played
+QuestionHandler* Lion::getActiveQuestions() {
+    return currentState == CurrentState::QuizActive ? questionHandler.get() : nullptr;
+}
@@ -11,6 +11,7 @@
 // project includes
 #include "Scene.h"
 #include "Dialogue.h"
+#include "NarrativeStore.h"
 #include "BackgroundManager.h"
 #include "GameScore.h"
 #include "QuestionHandler.h"
@@ -19,7 +20,7 @@
 class Lion : public Scene<Lion> {
 public:
     // -- constructor --
-    Lion(sf::RenderWindow& window);
+    Lion(sf::RenderTarget& window);
 
     // -- core game loop methods --
     void loadResources() override;            // loads resources for the scene (textures, dialogues, questions)
@@ -31,6 +32,11 @@ public:
     // -- layout and quiz logic --
     void resize();                            // adjusts visuals for window resizing
     bool areQuestionsComplete() const;        // checks if all questions have been answered
+    QuestionHandler* getActiveQuestions();    // the quiz while it is on screen, nullptr otherwise
+
+    // -- save and resume --
+    SceneSnapshot getSnapshot() const;        // where the scene is, for a save
+    void restore(const SceneSnapshot& snapshot); // picks up there, on a freshly reset scene (GameScore holds the saved scores)
 
 private:
     // -- background rendering --
@@ -53,13 +59,12 @@ private:
     bool enterPressed = false;                  // tracks Enter key press
 
     // -- quiz data --
-    std::vector<QuestionHandler::Question> lionQuestions;     // list of questions for the Lion level
     std::unique_ptr<QuestionHandler> questionHandler;         // manages question rendering & answer checking
     int finalScore;                                           // stores final quiz score
     GameScore& gameScore = GameScore::getInstance();          // singleton to store cumulative score
 
     // -- dialogue data --
-    std::vector<Dialogue::DialogueLine> lionDialogues;        // stores dialogue lines for Lion level
+    NarrativeStore::Sequence lionDialogues;        // stores dialogue lines for Lion level
     size_t currentDialogueIndex = 0;                          // tracks current line in dialogue
     std::unique_ptr<Dialogue> lionDialogue;                   // manages text rendering and progression
 
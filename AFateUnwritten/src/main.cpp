@@ -0,0 +1,62 @@
+#include <iostream>
+#include <string>
+
+#include "Game.h"
+#include "Input.h"
+#include "Trace.h"
+
+using namespace std;
+
+// create game instance and start main loop (for Release)
+//int WinMain() {
+//    Game game;
+//    game.run();
+//    return 0;
+//}
+
+// create game instance and start main loop (for Debug with terminal)
+// --headless renders into an offscreen texture, --null-render skips GPU work entirely
+// --letterbox lays the game out once and shows it scaled into the window (resizing doesn't relayout)
+// --record <file> writes the session's input to file, --replay <file> plays such a file back
+// --trace <file> writes a Chrome trace (chrome://tracing, ui.perfetto.dev) of the session on exit
+int main(int argc, char* argv[]) {
+    Game::RenderMode mode = Game::RenderMode::Window;
+    string tracePath;
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (arg == "--headless") {
+            mode = Game::RenderMode::Offscreen;
+        }
+        else if (arg == "--null-render") {
+            mode = Game::RenderMode::Null;
+        }
+        else if (arg == "--letterbox") {
+            mode = Game::RenderMode::Letterbox;
+        }
+        else if (arg == "--record" && i + 1 < argc) {
+            Input::getInstance().startRecording(argv[++i]);
+        }
+        else if (arg == "--replay" && i + 1 < argc) {
+            Input::getInstance().startReplay(argv[++i]);
+        }
+        else if (arg == "--trace" && i + 1 < argc) {
+            tracePath = argv[++i];
+        }
+    }
+
+    if (!tracePath.empty()) {
+        Trace::getInstance().setThreadName("main");
+        Trace::getInstance().start();
+    }
+
+    Game game(mode);
+    game.run();
+
+    if (!tracePath.empty()) {
+        Trace::getInstance().stop();
+        if (!Trace::getInstance().writeChromeJson(tracePath)) {
+            cerr << "Could not write trace to " << tracePath << endl;
+        }
+    }
+    return 0;
+}
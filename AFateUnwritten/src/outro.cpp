@@ -3,6 +3,8 @@
 #include "LoadResources.h"
 #include "ResizeManager.h"
 #include "GameScore.h"
+#include "Input.h"
+#include "FrameProfiler.h"
 
 #include <sstream> 
 
@@ -10,7 +12,7 @@ using namespace std;
 using namespace sf;
 
 // constructor: initializes Outro scene, load resources and resize elements
-Outro::Outro(RenderWindow& window) : playGif(false), Scene(window) { 
+Outro::Outro(RenderTarget& window) : playGif(false), Scene(window) { 
     resourceLoader(font, "resources/fonts/INFROMAN.ttf");
     loadResources();
     resize();
@@ -20,7 +22,17 @@ Outro::Outro(RenderWindow& window) : playGif(false), Scene(window) {
 void Outro::loadResources() {
     // load background triggers from OutroNarrative
     OutroNarrative::getBackgroundTriggers(bgManager);
+    bgManager.prefetch();
 
+    chooseEnding();
+    overlayText.setFont(font);
+
+    // load first line of dialogue
+    loadCurrentDialogue();          
+}
+
+// the ending depends on the scores, so it is picked again whenever the outro restarts
+void Outro::chooseEnding() {
     // get scores and determine if player passed
     passed = gameScore.Condition(GameScore::TOTALSCORE);
 
@@ -39,15 +51,10 @@ void Outro::loadResources() {
 
     bgManager.setDefault(passed ? "resources/images/good_ending.png" : "resources/images/bad_ending.png");
 
-    // load GIF only for bad ending
-    if (!passed) {                  
+    // load GIF only for bad ending, and only the first time
+    if (!passed && !gifAnimator.areFramesLoaded()) {
         gifAnimator.loadFrames();
     }
-
-    overlayText.setFont(font);
-
-    // load first line of dialogue
-    loadCurrentDialogue();          
 }
 
 // load the current dialogue line
@@ -57,10 +64,14 @@ void Outro::loadCurrentDialogue() {
         return;
     }
     const auto& line = outroDialogues[currentDialogueIndex];
+    if (outroDialogue) {
+        outroDialogue->setLine(line);
+        return;
+    }
     outroDialogue = make_unique<Dialogue>(window, line.speaker, line.text);
 
     // hook up background change triggers
-    outroDialogue->setBackgroundChanges(bgManager.getTriggerMap());
+    outroDialogue->setBackgroundTriggers(OutroNarrative::getTriggerAutomaton());
     outroDialogue->setBackgroundChangeCallback([&](const string& key) {
         bgManager(key);
     });
@@ -76,24 +87,23 @@ void Outro::render() {
     }
     else if (playGif) {
         gifAnimator.draw(window);
-        window.draw(overlayText);
-        for (auto& line : overlayLines) window.draw(line);
+        FrameProfiler::draw(window, overlayText);
+        for (auto& line : overlayLines) FrameProfiler::draw(window, line);
 
         if (gifAnimator.isAnimationComplete()) {
-            window.draw(promptText);
+            FrameProfiler::draw(window, promptText);
         }
     }
     else if (outroDialogue) {
         bgManager.draw(window);
         outroDialogue->render();
     }
-    window.display();
 }
 
 // main update loop
 void Outro::update() {
     if (showingResults) {
-        if (Keyboard::isKeyPressed(Keyboard::Enter) && !enterPressed) {
+        if (Input::getInstance().isKeyPressed(Keyboard::Enter) && !enterPressed) {
             enterPressed = true;
             showingResults = false;
             loadCurrentDialogue();
@@ -129,7 +139,7 @@ void Outro::update() {
                 return; //move on to next dialogue
             }
 
-            if (Keyboard::isKeyPressed(Keyboard::Enter) && !enterPressed) {
+            if (Input::getInstance().isKeyPressed(Keyboard::Enter) && !enterPressed) {
                 enterPressed = true;
                 currentDialogueIndex++;
 
@@ -145,7 +155,7 @@ void Outro::update() {
     }
 
     // reset enterPressed when key is released
-    if (!Keyboard::isKeyPressed(Keyboard::Enter)) {
+    if (!Input::getInstance().isKeyPressed(Keyboard::Enter)) {
         enterPressed = false;
     }
 }
@@ -196,7 +206,7 @@ void Outro::updateGifAnimation() {
         FloatRect bounds = promptText.getLocalBounds();
         promptText.setFont(font);
         promptText.setFillColor(Color::White);
-        promptText.setString("[Press Enter]");
+        FrameProfiler::setString(promptText, "[Press Enter]");
 
         promptText.setCharacterSize(static_cast<unsigned int>(scaledTextSize));
         promptText.setOrigin(bounds.width, bounds.height); // origin at bottom-right corner of the text
@@ -207,7 +217,7 @@ void Outro::updateGifAnimation() {
             window.getSize().y - 40.f * scale.y
         );
         // wait for Enter input to mark outro as finished
-        if (Keyboard::isKeyPressed(Keyboard::Enter) && !enterPressed) {
+        if (Input::getInstance().isKeyPressed(Keyboard::Enter) && !enterPressed) {
             enterPressed = true;
             playGif = false;
             triggerChecked = false;
@@ -236,7 +246,7 @@ void Outro::updateReportLayout() {
     outroReport.setFillColor(Color::White);
     float scaledTextSize = ResizeManager::scaleText(40, scale.y);
     outroReport.setCharacterSize(static_cast<unsigned int>(scaledTextSize));
-    outroReport.setString(report);
+    FrameProfiler::setString(outroReport, report);
 
     outroReport.setPosition(
         box.getPosition().x + 20 * scale.x,
@@ -246,11 +256,17 @@ void Outro::updateReportLayout() {
 
 // reset the outro scene
 void Outro::reset() {
-    outroDialogue->reset();
+    chooseEnding();
     playGif = false;
     triggerChecked = false;
+    lastTriggeredIndex = -1;
     currentDialogueIndex = 0;
     showingResults = true;
+    outroFinished = false;
+    enterPressed = false;
+    overlayLines.clear();
+    gifAnimator.restart();
+    loadCurrentDialogue();  // the first line again (the dialogue box is kept, or made if the last run used it up)
 }
 
 // check if text is completely displayed
@@ -296,6 +312,6 @@ void Outro::progressReport(Color c) {
     report = ss.str();
 
     updateReportLayout(); // apply size and position after setting text
-    window.draw(box);
-    window.draw(outroReport);
+    FrameProfiler::draw(window, box);
+    FrameProfiler::draw(window, outroReport);
 }
\ No newline at end of file
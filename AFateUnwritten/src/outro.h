@@ -11,6 +11,7 @@
 // project includes
 #include "Scene.h"
 #include "Dialogue.h"
+#include "NarrativeStore.h"
 #include "BackgroundManager.h"
 #include "GameScore.h"
 #include "GifAnimator.h" 
@@ -19,13 +20,13 @@
 class Outro : public Scene<Outro> {       // Outro uses the Scene template
 public:
     // -- constructor --
-    Outro(sf::RenderWindow& window);      // constructor takes window reference to display scene
+    Outro(sf::RenderTarget& window);      // constructor takes window reference to display scene
 
     // -- core game loop methods --
     void loadResources() override;        // loads necessary resources (like background img)
     void render() override;               // rdraws intro, including bg and any text
     void update() override;               // updates dialogue, checking for scene transitions and user input
-    void reset() override;                // resets intro, useful for reloading or restarting
+    void reset() override;                // restarts the outro for the current scores, keeping everything loaded
     bool isTextComplete() const override; // checks if all dialogue text has been fully displayed
 
     // -- flag to mark end of outro --
@@ -34,7 +35,7 @@ public:
     // -- responsive UI support --
     void resize();                        // updates positions and scales of ui elements when window is resized
 
-    bool isPlayingGif() {                 // used in game to play gif sound specifically
+    bool isPlayingGif() const {           // used in game to play gif sound specifically
         return playGif;  
     }
 
@@ -60,10 +61,11 @@ private:
     // -- user input and dialogue --
     bool waitingForInput;                      // true if waiting for player to press Enter
     bool enterPressed = false;                 // tracks Enter key press
-    std::vector<Dialogue::DialogueLine> outroDialogues; // stores dialogue lines for Outro scene
+    NarrativeStore::Sequence outroDialogues; // stores dialogue lines for Outro scene
     size_t currentDialogueIndex = 0;           // tracks current line in dialogue
     std::unique_ptr<Dialogue> outroDialogue;   // manages text rendering and progression
     void loadCurrentDialogue();                // helper function to load the next dialogue line
+    void chooseEnding();                       // picks the ending for the current scores (dialogue, background, colour, gif)
 
     // -- gif animation --
     bool triggerChecked = false;               // ensures the gif animation only triggers once when conditions are met
@@ -1,30 +1,38 @@
 ﻿#include "Scarecrow.h"
 #include "ScarecrowNarrative.h"
+#include "Input.h"
+#include "EventBus.h"
+#include "GameEvents.h"
 
 using namespace sf;
 using namespace std;
 
 // constructor: initialize Scarecrow scene, load resources, prepare questions, and resize elements
-Scarecrow::Scarecrow(RenderWindow& window) : Scene(window), finalScore(0) {
+Scarecrow::Scarecrow(RenderTarget& window) : Scene(window), finalScore(0) {
     loadResources();
     initializeQuestions();
     resize();
 }
 
 void Scarecrow::initializeQuestions() {
-    scarecrowQuestions = ScarecrowNarrative::getScarecrowQuestions(); // retrieve question bank from narrative 
     questionHandler = make_unique<QuestionHandler>(window); // create new question handler
-    questionHandler->setQuestions(scarecrowQuestions); // load question bank to question handler
-    questionHandler->selectRandomQuestions(10); // select 10 random questions from the question bank
+    drawQuestions();
     questionHandler->setButtonColor(LevelType::Scarecrow); // set colour of question buttons 
+    questionHandler->setScoreType(GameScore::SCARECROW); // answers count for the scarecrow score
+}
+
+void Scarecrow::drawQuestions() {
+    questionIds = ScarecrowNarrative::drawScarecrowQuestionIds(10); // 10 questions the player hasn't seen yet
+    questionHandler->setQuestions(ScarecrowNarrative::getScarecrowQuestions(questionIds));
+    questionsUsed = false;
 }
 
 void Scarecrow::loadResources() {
     bgManager.setDefault("resources/images/scarecrow_sad.png");
     ScarecrowNarrative::getBackgroundTriggers(bgManager); // retrieve the triggers that will register any background changes 
+    bgManager.prefetch(); // decode the trigger backgrounds on the job system before they are needed
 
-    auto start = ScarecrowNarrative::getStartNarrative(); // load initial dialogue (pre-quiz narrative)
-    scarecrowDialogues.assign(start.begin(), start.end());
+    scarecrowDialogues = ScarecrowNarrative::getStartNarrative(); // load initial dialogue (pre-quiz narrative)
 
     loadCurrentDialogue();
 }
@@ -33,9 +41,13 @@ void Scarecrow::loadCurrentDialogue() {
     if (currentDialogueIndex >= scarecrowDialogues.size()) return; // end of dialogue
 
     const auto& line = scarecrowDialogues[currentDialogueIndex]; // current dialogue line
+    if (scarecrowDialogue) {
+        scarecrowDialogue->setLine(line); // already set up: just show who is speaking and what they say
+        return;
+    }
     scarecrowDialogue = make_unique<Dialogue>(window, line.speaker, line.text); // create dialogue object , initialize who the speaker is and what they are saying 
 
-    scarecrowDialogue->setBackgroundChanges(bgManager.getTriggerMap());
+    scarecrowDialogue->setBackgroundTriggers(ScarecrowNarrative::getTriggerAutomaton());
     scarecrowDialogue->setBackgroundChangeCallback([&](const string& key) {
         bgManager(key); // change background using operator()
     });
@@ -55,6 +67,7 @@ void Scarecrow::update() {
                 }
                 else { // otherwise switch to quiz state when all pre-quiz dialogue is done
                     currentState = CurrentState::QuizActive;
+                    questionsUsed = true; // a retry gets a fresh draw
                     questionHandler->reset(); // reset quiz state
                     questionHandler->loadCurrentQuestion(); // start first question
                 }
@@ -63,12 +76,10 @@ void Scarecrow::update() {
         break;
 
     case CurrentState::QuizActive:
-        questionHandler->update(); // perform quiz question handling (button clicks, scoring)
-
-        gameScore.setScore(GameScore::SCARECROW, questionHandler->getScore());
-        finalScore = gameScore.getScore(GameScore::SCARECROW);
+        questionHandler->update(); // perform quiz question handling (button clicks, scoring), answers go to GameScore as events
 
         if (questionHandler->isComplete()) { // if quiz is complete
+            finalScore = questionHandler->getScore();
             currentState = CurrentState::ShowingResults; // then move to the next state - progress report
             currentDialogueIndex = 0; // mark beginning of the end narrative
 
@@ -82,7 +93,7 @@ void Scarecrow::update() {
         break;
 
     case CurrentState::ShowingResults:
-        if (Keyboard::isKeyPressed(Keyboard::Enter) && !enterPressed) { // if the user presses the enter key
+        if (Input::getInstance().isKeyPressed(Keyboard::Enter) && !enterPressed) { // if the user presses the enter key
             enterPressed = true;
             currentState = CurrentState::PostQuizDialogue; // then move to the next state - scarecrow good/bad ending
             loadCurrentDialogue();
@@ -98,12 +109,15 @@ void Scarecrow::update() {
                 if (currentDialogueIndex < scarecrowDialogues.size()) { // if post-quiz dialogue remain
                     loadCurrentDialogue(); // then load next line
                 }
+                else if (currentDialogueIndex == scarecrowDialogues.size()) { // last line just finished
+                    EventBus::getInstance().publish(ChapterCompleted{ Chapter::Scarecrow }); // Game moves on with Enter
+                }
             }
         }
         break;
     }
 
-    if (!Keyboard::isKeyPressed(Keyboard::Enter)) { // reset enter key state to allow dialogue to progress
+    if (!Input::getInstance().isKeyPressed(Keyboard::Enter)) { // reset enter key state to allow dialogue to progress
         enterPressed = false;
     }
 }
@@ -126,40 +140,76 @@ void Scarecrow::render() {
         }
         break;
     }
-
-    window.display();
 }
 
 bool Scarecrow::areQuestionsComplete() const {
     return questionHandler && questionHandler->isComplete();  // returns true if all quiz questions are answered
 }
 
+QuestionHandler* Scarecrow::getActiveQuestions() {
+    return currentState == CurrentState::QuizActive ? questionHandler.get() : nullptr;  // only while the quiz is on screen
+}
+
 void Scarecrow::reset() {
     bgManager.setDefault("resources/images/scarecrow_sad.png");
 
-    // reset scarecrow dialogue if it exists
-    if (scarecrowDialogue) {
-        scarecrowDialogue->reset();
-    }
     // reset all state variables
     currentDialogueIndex = 0;
     finalScore = 0;
     enterPressed = false;
     currentState = CurrentState::PreQuizDialogue;
 
-    // reload pre-quiz dialogue
-    scarecrowDialogues.clear();
-    auto start = ScarecrowNarrative::getStartNarrative();
-    scarecrowDialogues.assign(start.begin(), start.end());
+    // reload pre-quiz dialogue (restarts the dialogue box on the first line)
+    scarecrowDialogues = ScarecrowNarrative::getStartNarrative();
     loadCurrentDialogue();
 
-    // reset question handler if it exists
+    // new questions once the last ones have been played, the handler itself is kept
+    if (questionHandler && questionsUsed) {
+        drawQuestions();
+    }
     if (questionHandler) {
         questionHandler->reset();
         questionHandler->setComplete(false);
     }
 }
 
+SceneSnapshot Scarecrow::getSnapshot() const {
+    SceneSnapshot snapshot;
+    snapshot.state = static_cast<int32_t>(currentState);
+    snapshot.dialogueIndex = static_cast<uint32_t>(currentDialogueIndex);
+    if (scarecrowDialogue) snapshot.typing = scarecrowDialogue->getTypingState();
+    snapshot.quiz = questionHandler->getQuizState();
+    snapshot.scores[0] = finalScore;
+    snapshot.backgroundKey = bgManager.getCurrentKey();
+    snapshot.questionIds = questionIds; // the draw is random, so the save keeps which questions came up
+    return snapshot;
+}
+
+void Scarecrow::restore(const SceneSnapshot& snapshot) {
+    if (snapshot.state < 0 || snapshot.state > static_cast<int32_t>(CurrentState::PostQuizDialogue)) return;
+    if (!snapshot.questionIds.empty() && snapshot.questionIds != questionIds) {
+        questionHandler->setQuestions(ScarecrowNarrative::getScarecrowQuestions(snapshot.questionIds)); // throws for questions no longer in the bank
+        questionIds = snapshot.questionIds;
+    }
+    questionsUsed = snapshot.state != static_cast<int32_t>(CurrentState::PreQuizDialogue);
+
+    currentState = static_cast<CurrentState>(snapshot.state);
+    if (currentState == CurrentState::ShowingResults || currentState == CurrentState::PostQuizDialogue) {
+        scarecrowDialogues = gameScore.Condition(GameScore::SCARECROW) // same ending the quiz picked
+            ? ScarecrowNarrative::getGoodEndNarrative()
+            : ScarecrowNarrative::getBadEndNarrative();
+    }
+    currentDialogueIndex = min<size_t>(snapshot.dialogueIndex, scarecrowDialogues.size() - 1);
+    finalScore = snapshot.scores[0];
+    bgManager.restoreKey(snapshot.backgroundKey);
+    questionHandler->setQuizState(snapshot.quiz);
+
+    if (currentState != CurrentState::QuizActive) {
+        loadCurrentDialogue();
+        scarecrowDialogue->setTypingState(snapshot.typing);
+    }
+}
+
 bool Scarecrow::isTextComplete() const {
     return scarecrowDialogue && scarecrowDialogue->isTextComplete(); // returns true if the current dialogue is fully displayed
 }
@@ -4,9 +4,12 @@
 // SFML & Standard Library Includes
 #include <SFML/Graphics.hpp>
 #include <memory>
+#include <vector>
+#include <cstdint>
 
 // project includes
 #include "Dialogue.h"
+#include "NarrativeStore.h"
 #include "Scene.h"
 #include "QuestionHandler.h"
 #include "BackgroundManager.h"
@@ -16,7 +19,7 @@
 class Scarecrow : public Scene<Scarecrow> {
 public:
     // -- constructor --
-    Scarecrow(sf::RenderWindow& window);
+    Scarecrow(sf::RenderTarget& window);
 
     // -- core game loop methods --
     void loadResources() override;            // loads resources for the scene (textures, dialogues, questions)
@@ -27,8 +30,13 @@ public:
 
     // -- layout and quiz logic --
     bool areQuestionsComplete() const;        // checks if all questions have been answered
+    QuestionHandler* getActiveQuestions();    // the quiz while it is on screen, nullptr otherwise
     void resize();                            // adjusts visuals for window resizing
 
+    // -- save and resume --
+    SceneSnapshot getSnapshot() const;        // where the scene is, for a save
+    void restore(const SceneSnapshot& snapshot); // picks up there, on a freshly reset scene (GameScore holds the saved scores)
+
 private:
     // -- background rendering --
     sf::Texture bgTexture;         // texture for background image
@@ -46,7 +54,7 @@ private:
     CurrentState currentState = CurrentState::PreQuizDialogue; // current state of the scene
 
     // -- dialogue data --
-    std::vector<Dialogue::DialogueLine> scarecrowDialogues;    // stores dialogue lines for Scarecrow level
+    NarrativeStore::Sequence scarecrowDialogues;    // stores dialogue lines for Scarecrow level
     std::size_t currentDialogueIndex = 0;                      // tracks current line in dialogue
     std::unique_ptr<Dialogue> scarecrowDialogue;               // manages text rendering and progression
 
@@ -55,14 +63,16 @@ private:
     bool enterPressed = false;   // tracks Enter key press
 
     // -- quiz data --
-    std::vector<QuestionHandler::Question> scarecrowQuestions; // list of questions for the Scarecrow level
     std::unique_ptr<QuestionHandler> questionHandler;          // manages question rendering & answer checking
+    std::vector<std::uint32_t> questionIds;                    // the drawn questions (QuestionStore indices), kept for saves
+    bool questionsUsed = false;                                // the quiz has shown them, a reset draws new ones
     int finalScore;                                            // stores final quiz score
     GameScore& gameScore = GameScore::getInstance();           // singleton to store cumulative score
 
     // -- helper methods --
     void loadCurrentDialogue();                                // loads and updates the active dialogue segment
     void initializeQuestions();               // loads questions into the question handler
+    void drawQuestions();                     // draws questions the player hasn't seen into the handler
 };
 
 #endif
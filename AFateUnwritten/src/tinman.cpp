@@ -2,13 +2,17 @@
 #include "TinmanNarrative.h"
 #include "ResizeManager.h"
 #include "LoadResources.h"
+#include "Input.h"
+#include "FrameProfiler.h"
+#include "EventBus.h"
+#include "GameEvents.h"
 
 using namespace std;
 using namespace sf;
 
 // constructor: initializes the Tinman scene
-Tinman::Tinman(RenderWindow& window)
-    : Scene(window), timer(window, 60){ // timer set to 60 seconds
+Tinman::Tinman(RenderTarget& window)
+    : Scene(window), timer(window, 60, "tinman.riddles"){ // timer set to 60 seconds
     loadResources();
     initializeHandlers();
     initializeUI();
@@ -18,16 +22,16 @@ Tinman::Tinman(RenderWindow& window)
 // sets up question and riddle handlers
 void Tinman::initializeHandlers() {
     // load Tinman quiz questions
-    tinmanQuestions = TinmanNarrative::getTinmanQuestions();
     questionHandler = make_unique<QuestionHandler>(window);
-    questionHandler->setQuestions(tinmanQuestions);
+    questionHandler->setQuestions(TinmanNarrative::getTinmanQuestions());
     questionHandler->setButtonColor(LevelType::Tinman);
+    questionHandler->setScoreType(GameScore::TINMANQUIZ);
 
     // load Tinman riddle questions
-    tinmanRiddles = TinmanNarrative::getTinmanRiddles();
     riddleHandler = make_unique<QuestionHandler>(window);
-    riddleHandler->setQuestions(tinmanRiddles);
+    riddleHandler->setQuestions(TinmanNarrative::getTinmanRiddles());
     riddleHandler->setButtonColor(LevelType::Tinman);
+    riddleHandler->setScoreType(GameScore::TINMANRIDDLE);
 }
 
 // initializes UI components like result and failure boxes
@@ -69,7 +73,7 @@ void Tinman::initializeUI() {
     failureText.setCharacterSize(static_cast<unsigned int>(scaledTextSize));
     failureText.setFillColor(Color::White);
     failureText.setStyle(Text::Bold);
-    failureText.setString("Time's up! The Tinman score has been reset to 0.");
+    FrameProfiler::setString(failureText, "Time's up! The Tinman score has been reset to 0.");
 
     // center the failure text inside the box
     FloatRect textBounds = failureText.getLocalBounds();
@@ -98,16 +102,16 @@ void Tinman::progressReport() {
     }
 
     ss << "Press Enter to continue your journey.";
-    resultText.setString(ss.str());
+    FrameProfiler::setString(resultText, ss.str());
 }
 
 // loads backgrounds and start dialogue
 void Tinman::loadResources() {
     bgManager.setDefault("resources/images/tinman_sad.png");
     TinmanNarrative::getBackgroundTriggers(bgManager);
+    bgManager.prefetch();
 
-    auto start = TinmanNarrative::getStartNarrative();
-    tinmanDialogues.assign(start.begin(), start.end());
+    tinmanDialogues = TinmanNarrative::getStartNarrative();
     loadCurrentDialogue();
 }
 
@@ -116,8 +120,12 @@ void Tinman::loadCurrentDialogue() {
     if (currentDialogueIndex >= tinmanDialogues.size()) return;
 
     const auto& line = tinmanDialogues[currentDialogueIndex];
+    if (tinmanDialogue) {
+        tinmanDialogue->setLine(line);
+        return;
+    }
     tinmanDialogue = make_unique<Dialogue>(window, line.speaker, line.text);
-    tinmanDialogue->setBackgroundChanges(bgManager.getTriggerMap());
+    tinmanDialogue->setBackgroundTriggers(TinmanNarrative::getTriggerAutomaton());
 
     // set a callback for background changes
     tinmanDialogue->setBackgroundChangeCallback([this](const string& key) {
@@ -178,6 +186,9 @@ void Tinman::update() {
                 if (currentDialogueIndex < tinmanDialogues.size()) {
                     loadCurrentDialogue();
                 }
+                else if (currentDialogueIndex == tinmanDialogues.size()) {
+                    EventBus::getInstance().publish(ChapterCompleted{ Chapter::Tinman });  // Game moves to the outro with Enter
+                }
             }
         }
         break;
@@ -185,19 +196,18 @@ void Tinman::update() {
         break;
     }
 
-    if (!Keyboard::isKeyPressed(Keyboard::Enter)) {
+    if (!Input::getInstance().isKeyPressed(Keyboard::Enter)) {
         enterPressed = false;
     }
 }
 
 // update handling for quiz section
 void Tinman::updateQuiz() {
-    questionHandler->update();
-    gameScore.setScore(GameScore::TINMANQUIZ, questionHandler->getScore());
-    quizScore = gameScore.getScore(GameScore::TINMANQUIZ);
+    questionHandler->update();  // GameScore hears about every answer from the handler
 
     // transition to pre-riddle dialogue when quiz finishes
     if (questionHandler->isComplete()) {
+        quizScore = questionHandler->getScore();
         currentState = CurrentState::PreRiddleDialogue;
         currentDialogueIndex = 0;
         tinmanDialogues = TinmanNarrative::getPreRiddleDialogue();
@@ -220,9 +230,7 @@ void Tinman::updateRiddles() {
     // player finished riddles in time
     else if (!timer.isComplete() && riddleHandler->isComplete()) {
         timer.stop();
-        gameScore.setScore(GameScore::TINMANRIDDLE, riddleHandler->getScore());
-        riddleScore = gameScore.getScore(GameScore::TINMANRIDDLE);
-        gameScore.setScore(GameScore::TINMAN, quizScore + riddleScore);
+        riddleScore = riddleHandler->getScore();  // GameScore already has it (and the Tinman total) from the answers
 
         tinmanDialogues = gameScore.Condition(GameScore::TINMAN)
             ? TinmanNarrative::getGoodEndNarrative()
@@ -238,7 +246,7 @@ void Tinman::updateRiddles() {
 // update handling for showing the result screen
 void Tinman::updateResults() {
     progressReport();
-    if (Keyboard::isKeyPressed(Keyboard::Enter) && !enterPressed) {
+    if (Input::getInstance().isKeyPressed(Keyboard::Enter) && !enterPressed) {
         enterPressed = true;
         currentState = CurrentState::PostQuizDialogue;
         currentDialogueIndex = 0;
@@ -260,19 +268,17 @@ void Tinman::render() {
         timer.render();
         break;
     case CurrentState::ShowingResults:
-        window.draw(resultBox);
-        window.draw(resultText);
+        FrameProfiler::draw(window, resultBox);
+        FrameProfiler::draw(window, resultText);
         if (showFailureBox) {
-            window.draw(failureBox);
-            window.draw(failureText);
+            FrameProfiler::draw(window, failureBox);
+            FrameProfiler::draw(window, failureText);
         }
         break;
     default:
         if (tinmanDialogue) tinmanDialogue->render();
         break;
     }
-
-    window.display();
 }
 
 // helper: check if all quiz questions are completed
@@ -280,6 +286,15 @@ bool Tinman::areQuestionsComplete() const {
     return questionHandler && questionHandler->isComplete();
 }
 
+// helper: the handler the player is answering right now (quiz or riddles)
+QuestionHandler* Tinman::getActiveQuestions() {
+    switch (currentState) {
+    case CurrentState::QuizActive: return questionHandler.get();
+    case CurrentState::RiddlesActive: return riddleHandler.get();
+    default: return nullptr;
+    }
+}
+
 // helper: check if all riddles are completed
 bool Tinman::areRiddlesComplete() const {
     return riddleHandler && riddleHandler->isComplete();
@@ -294,6 +309,7 @@ void Tinman::reset() {
     riddleScore = 0;
     enterPressed = false;
     showFailureBox = false;
+    timer.stop();   // a retry mid-riddles mustn't keep counting
 
     tinmanDialogues = TinmanNarrative::getStartNarrative();
     loadCurrentDialogue();
@@ -302,6 +318,64 @@ void Tinman::reset() {
     if (riddleHandler) riddleHandler->reset();
 }
 
+// records the state machine, the line being typed, both handlers, the riddle timer and the background
+SceneSnapshot Tinman::getSnapshot() const {
+    SceneSnapshot snapshot;
+    snapshot.state = static_cast<int32_t>(currentState);
+    snapshot.dialogueIndex = static_cast<uint32_t>(currentDialogueIndex);
+    if (tinmanDialogue) snapshot.typing = tinmanDialogue->getTypingState();
+    snapshot.quiz = questionHandler->getQuizState();
+    snapshot.riddles = riddleHandler->getQuizState();
+    snapshot.scores[0] = quizScore;
+    snapshot.scores[1] = riddleScore;
+    if (timer.isRunning()) {
+        snapshot.timerMillis = static_cast<int32_t>(timer.getElapsedTime() * 1000.0f);
+    }
+    snapshot.showFailureBox = showFailureBox;
+    snapshot.backgroundKey = bgManager.getCurrentKey();
+    return snapshot;
+}
+
+// resumes a save: the quiz and riddle scores go back into GameScore first, the ending depends on them
+void Tinman::restore(const SceneSnapshot& snapshot) {
+    if (snapshot.state < 0 || snapshot.state > static_cast<int32_t>(CurrentState::PreRiddleDialogue)) return;
+    currentState = static_cast<CurrentState>(snapshot.state);
+    quizScore = snapshot.scores[0];
+    riddleScore = snapshot.scores[1];
+    showFailureBox = snapshot.showFailureBox;
+    if (currentState != CurrentState::PreQuizDialogue && !showFailureBox) {
+        gameScore.setScore(GameScore::TINMANQUIZ, snapshot.quiz.score);
+        gameScore.setScore(GameScore::TINMANRIDDLE, snapshot.riddles.score);  // riddles answered so far
+    }
+
+    switch (currentState) {
+    case CurrentState::PreRiddleDialogue:
+        tinmanDialogues = TinmanNarrative::getPreRiddleDialogue();
+        break;
+    case CurrentState::ShowingResults:
+    case CurrentState::PostQuizDialogue:
+        tinmanDialogues = !showFailureBox && gameScore.Condition(GameScore::TINMAN)
+            ? TinmanNarrative::getGoodEndNarrative()
+            : TinmanNarrative::getBadEndNarrative();
+        break;
+    default:
+        break;
+    }
+    currentDialogueIndex = min<size_t>(snapshot.dialogueIndex, tinmanDialogues.size() - 1);
+    bgManager.restoreKey(snapshot.backgroundKey);
+    questionHandler->setQuizState(snapshot.quiz);
+    riddleHandler->setQuizState(snapshot.riddles);
+    if (snapshot.timerMillis >= 0) {
+        timer.resumeAt(snapshot.timerMillis / 1000.0f);
+    }
+
+    if (currentState == CurrentState::PreQuizDialogue || currentState == CurrentState::PreRiddleDialogue
+        || currentState == CurrentState::PostQuizDialogue) {
+        loadCurrentDialogue();
+        tinmanDialogue->setTypingState(snapshot.typing);
+    }
+}
+
 // helper: Check if current dialogue is complete
 bool Tinman::isTextComplete() const {
     return tinmanDialogue && tinmanDialogue->isTextComplete();
@@ -9,6 +9,7 @@
 
 // project includes
 #include "Dialogue.h"
+#include "NarrativeStore.h"
 #include "Timer.h"
 #include "Scene.h"
 #include "BackgroundManager.h"
@@ -19,7 +20,7 @@
 class Tinman : public Scene<Tinman> {
 public:
     // -- constructor --
-    Tinman(sf::RenderWindow& window);
+    Tinman(sf::RenderTarget& window);
 
     // -- core scene methods --
     void loadResources() override;        // loads textures, dialogues, questions, etc.
@@ -32,6 +33,12 @@ public:
     // -- progress checkers --
     bool areQuestionsComplete() const;    // checks if all quiz questions have been answered
     bool areRiddlesComplete() const;      // checks if all riddles have been answered
+    QuestionHandler* getActiveQuestions();// the quiz or riddles while on screen, nullptr otherwise
+    bool areRiddlesActive() const { return currentState == CurrentState::RiddlesActive; } // the riddle timer is running
+
+    // -- save and resume --
+    SceneSnapshot getSnapshot() const;    // where the scene is, for a save
+    void restore(const SceneSnapshot& snapshot); // picks up there, on a freshly reset scene (GameScore holds the saved scores)
 
 private:
     // -- enum to control scene flow --
@@ -62,13 +69,11 @@ private:
     bool enterPressed = false;             // tracks if Enter key was pressed
 
     // -- dialogue system --
-    std::vector<Dialogue::DialogueLine> tinmanDialogues; // Tinman's dialogues
+    NarrativeStore::Sequence tinmanDialogues; // Tinman's dialogues
     size_t currentDialogueIndex = 0;                     // current dialogue line index
     std::unique_ptr<Dialogue> tinmanDialogue;            // dialogue manager
 
     // -- question and riddle handling --
-    std::vector<QuestionHandler::Question> tinmanQuestions; // quiz questions
-    std::vector<QuestionHandler::Question> tinmanRiddles;   // riddle questions
     std::unique_ptr<QuestionHandler> questionHandler;       // quiz handler
     std::unique_ptr<QuestionHandler> riddleHandler;         // riddle handler
 
@@ -0,0 +1,645 @@
+// compiles the story scripts (resources/narrative/*.story) into the narrative.bin the game maps at runtime,
+// and the quiz scripts (*.quiz) into questions.bin
+//
+// usage: NarrativeCompiler <script directory> <output file> [--font font.ttf] [--questions questions.bin]
+// with --font every line is also pre-wrapped into dialogue box chunks for the standard window sizes below,
+// measured with the game's own wrapping code (TextWrap), the game wraps at runtime for any other size
+// quiz scripts are always checked, but only written with --questions
+// outputs whose bytes wouldn't change are not rewritten (the project builds them from the tracked scripts)
+// exit code: 0 = written, 1 = a script has errors (nothing is written), 2 = bad arguments or unwritable output
+//
+// script format, one file per chapter (the file name is the chapter, e.g. lion.story):
+//   # comment
+//   == start                         starts the sequence "lion.start"
+//   Lion: I... I don't know if       starts a line spoken by Lion (a Dialogue::DialogueType name)
+//       I can.                       indented lines continue the line, joined with one space (none after a "\n")
+//   trigger "As you approach" -> resources/images/lion_before.png
+//                                    shows the image once the phrase is on screen (the phrase has to occur
+//                                    in the chapter's text, an unmatched trigger would never fire, and the
+//                                    image has to exist relative to the working directory, as the game loads it)
+// "\n" in a line is a line break, blank lines are ignored
+//
+// quiz format, one file per chapter (lion.quiz), text is passed to the game byte for byte (Windows-1252):
+//   == questions                     starts the bank "lion.questions"
+//   ? Lion, what do you think        starts a question, indented lines continue it like story lines
+//   - Bravery is never being afraid. a wrong answer
+//   * Bravery isn't about never      the right answer, exactly one per question
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "NarrativeFormat.h"
+#include "QuestionFormat.h"
+#include "TextWrap.h"
+
+using namespace std;
+using namespace NarrativeFormat;
+namespace fs = std::filesystem;
+
+namespace {
+
+// window sizes the story is pre-wrapped for: the game's default window and common desktop resolutions
+const sf::Vector2u standardSizes[] = {
+    { 1408, 728 }, { 1280, 720 }, { 1366, 768 }, { 1600, 900 }, { 1920, 1080 }, { 2560, 1440 }
+};
+
+struct Line {
+    uint32_t speaker;
+    string text;
+};
+
+struct Sequence {
+    string name;                        // chapter.sequence
+    vector<Line> lines;
+};
+
+struct Trigger {
+    string chapter;
+    string phrase;
+    string imagePath;
+    string location;                    // file:line for messages
+};
+
+struct Question {
+    string text;
+    vector<string> options;
+    int correctOption;                  // -1 until the "*" answer shows up
+    string location;                    // file:line for messages
+};
+
+struct Bank {
+    string name;                        // chapter.bank
+    vector<Question> questions;
+};
+
+// everything parsed so far, plus the errors found on the way
+struct Narrative {
+    vector<Sequence> sequences;
+    vector<Trigger> triggers;
+    vector<Bank> banks;
+    vector<string> errors;
+};
+
+string trim(const string& text) {
+    size_t first = text.find_first_not_of(" \t\r");
+    if (first == string::npos) return "";
+    size_t last = text.find_last_not_of(" \t\r");
+    return text.substr(first, last - first + 1);
+}
+
+string unescape(const string& text) {
+    string result;
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (text[i] == '\\' && i + 1 < text.size() && text[i + 1] == 'n') {
+            result += '\n';
+            ++i;
+        }
+        else {
+            result += text[i];
+        }
+    }
+    return result;
+}
+
+// appends an indented continuation line
+void continueText(string& text, const string& more) {
+    if (text.empty() || text.back() != '\n') text += " ";
+    text += unescape(more);
+}
+
+int speakerIndex(const string& name) {
+    for (uint32_t i = 0; i < speakerCount; ++i) {
+        if (name == speakerNames[i]) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+// parses one chapter script into narrative
+void parseScript(const fs::path& path, Narrative& narrative) {
+    ifstream file(path);
+    if (!file.is_open()) {
+        narrative.errors.push_back(path.string() + ": can't open");
+        return;
+    }
+
+    const string chapter = path.stem().string();
+    Sequence* sequence = nullptr;
+    Line* line = nullptr;
+    string raw;
+    int lineNumber = 0;
+
+    while (getline(file, raw)) {
+        ++lineNumber;
+        string location = path.filename().string() + ":" + to_string(lineNumber);
+        string text = trim(raw);
+        if (text.empty() || text[0] == '#') continue;
+
+        bool indented = raw[0] == ' ' || raw[0] == '\t';
+        if (indented) {
+            if (!line) {
+                narrative.errors.push_back(location + ": continuation without a line to continue");
+                continue;
+            }
+            continueText(line->text, text);
+            continue;
+        }
+        line = nullptr;
+
+        if (text.compare(0, 2, "==") == 0) {
+            string name = chapter + "." + trim(text.substr(2));
+            for (const Sequence& existing : narrative.sequences) {
+                if (existing.name == name) narrative.errors.push_back(location + ": sequence " + name + " defined twice");
+            }
+            narrative.sequences.push_back({ name, {} });
+            sequence = &narrative.sequences.back();
+            continue;
+        }
+
+        if (text.compare(0, 8, "trigger ") == 0) {
+            size_t open = text.find('"');
+            size_t close = open == string::npos ? string::npos : text.find('"', open + 1);
+            size_t arrow = close == string::npos ? string::npos : text.find("->", close);
+            if (arrow == string::npos) {
+                narrative.errors.push_back(location + ": expected trigger \"phrase\" -> image");
+                continue;
+            }
+            narrative.triggers.push_back({ chapter, text.substr(open + 1, close - open - 1),
+                trim(text.substr(arrow + 2)), location });
+            continue;
+        }
+
+        size_t colon = text.find(':');
+        int speaker = colon == string::npos ? -1 : speakerIndex(text.substr(0, colon));
+        if (speaker < 0) {
+            narrative.errors.push_back(location + ": expected \"Speaker: text\" with one of Narrator, Dorothy, Lion, "
+                "Scarecrow, Tinman, Wizard");
+            continue;
+        }
+        if (!sequence) {
+            narrative.errors.push_back(location + ": line before the first \"== sequence\"");
+            continue;
+        }
+        sequence->lines.push_back({ static_cast<uint32_t>(speaker), unescape(trim(text.substr(colon + 1))) });
+        line = &sequence->lines.back();
+    }
+}
+
+// parses one chapter's quiz script into narrative.banks
+void parseQuiz(const fs::path& path, Narrative& narrative) {
+    ifstream file(path, ios::binary);
+    if (!file.is_open()) {
+        narrative.errors.push_back(path.string() + ": can't open");
+        return;
+    }
+
+    const string chapter = path.stem().string();
+    Bank* bank = nullptr;
+    Question* question = nullptr;
+    bool continuable = false;           // the last line was the question text
+    string raw;
+    int lineNumber = 0;
+
+    while (getline(file, raw)) {
+        ++lineNumber;
+        string location = path.filename().string() + ":" + to_string(lineNumber);
+        string text = trim(raw);
+        if (text.empty() || text[0] == '#') continue;
+
+        bool indented = raw[0] == ' ' || raw[0] == '\t';
+        if (indented) {
+            if (!continuable) {
+                narrative.errors.push_back(location + ": continuation without a question to continue");
+                continue;
+            }
+            continueText(question->text, text);
+            continue;
+        }
+        continuable = false;
+
+        if (text.compare(0, 2, "==") == 0) {
+            string name = chapter + "." + trim(text.substr(2));
+            for (const Bank& existing : narrative.banks) {
+                if (existing.name == name) narrative.errors.push_back(location + ": bank " + name + " defined twice");
+            }
+            narrative.banks.push_back({ name, {} });
+            bank = &narrative.banks.back();
+            question = nullptr;
+            continue;
+        }
+
+        if (text[0] == '?') {
+            if (!bank) {
+                narrative.errors.push_back(location + ": question before the first \"== bank\"");
+                continue;
+            }
+            bank->questions.push_back({ unescape(trim(text.substr(1))), {}, -1, location });
+            question = &bank->questions.back();
+            continuable = true;
+            continue;
+        }
+
+        if (text[0] == '-' || text[0] == '*') {
+            if (!question) {
+                narrative.errors.push_back(location + ": answer before the first \"? question\"");
+                continue;
+            }
+            if (text[0] == '*') {
+                if (question->correctOption >= 0) narrative.errors.push_back(location + ": second right answer");
+                question->correctOption = static_cast<int>(question->options.size());
+            }
+            question->options.push_back(unescape(trim(text.substr(1))));
+            continue;
+        }
+
+        narrative.errors.push_back(location + ": expected \"== bank\", \"? question\", \"- answer\" or \"* right answer\"");
+    }
+}
+
+// every question needs answers to choose from and a right one, every bank needs questions
+void checkBanks(Narrative& narrative) {
+    for (const Bank& bank : narrative.banks) {
+        if (bank.questions.empty()) narrative.errors.push_back("bank " + bank.name + " has no questions");
+        for (const Question& question : bank.questions) {
+            if (question.options.size() < 2) narrative.errors.push_back(question.location + ": question needs at least two answers");
+            if (question.correctOption < 0) narrative.errors.push_back(question.location + ": question has no \"*\" right answer");
+        }
+    }
+}
+
+// a trigger only fires if its phrase shows up in one of its chapter's lines, and only shows something if its
+// image is there
+void checkTriggers(Narrative& narrative) {
+    for (size_t i = 0; i < narrative.triggers.size(); ++i) {
+        const Trigger& trigger = narrative.triggers[i];
+        if (trigger.phrase.empty() || trigger.phrase.find('\n') != string::npos) {
+            narrative.errors.push_back(trigger.location + ": trigger phrase must be non-empty and on one line");
+        }
+        for (size_t j = 0; j < i; ++j) {
+            if (narrative.triggers[j].chapter == trigger.chapter && narrative.triggers[j].phrase == trigger.phrase) {
+                narrative.errors.push_back(trigger.location + ": trigger phrase \"" + trigger.phrase + "\" already used at "
+                    + narrative.triggers[j].location);
+            }
+        }
+        error_code error;
+        if (!fs::is_regular_file(trigger.imagePath, error)) {
+            narrative.errors.push_back(trigger.location + ": trigger image " + trigger.imagePath + " does not exist");
+        }
+
+        bool found = false;
+        for (const Sequence& sequence : narrative.sequences) {
+            if (sequence.name.compare(0, trigger.chapter.size() + 1, trigger.chapter + ".") != 0) continue;
+            for (const Line& line : sequence.lines) {
+                found = found || line.text.find(trigger.phrase) != string::npos;
+            }
+        }
+        if (!found) {
+            narrative.errors.push_back(trigger.location + ": trigger phrase \"" + trigger.phrase
+                + "\" does not occur in any line of " + trigger.chapter);
+        }
+    }
+}
+
+// a chapter's phrases as a DFA: the Aho-Corasick trie with every failure link followed ahead of time, so reading
+// a character is one lookup. bytes that occur in no phrase share column 0, '\n' is column 1 and stays put
+struct Automaton {
+    array<uint32_t, 256> classes{};             // byte -> column
+    uint32_t columnCount = 2;
+    vector<uint32_t> transitions;               // row per state
+    vector<vector<uint32_t>> matches;           // per state, the triggers (chapter local) ending there
+};
+
+Automaton buildAutomaton(const vector<string>& phrases) {
+    Automaton automaton;
+    automaton.classes['\n'] = 1;
+    for (const string& phrase : phrases) {
+        for (char c : phrase) {
+            uint32_t& column = automaton.classes[static_cast<unsigned char>(c)];
+            if (column == 0) column = automaton.columnCount++;
+        }
+    }
+    const uint32_t columns = automaton.columnCount;
+    const uint32_t none = UINT32_MAX;
+
+    // trie
+    vector<uint32_t> next(columns, none);
+    automaton.matches.resize(1);
+    for (uint32_t trigger = 0; trigger < phrases.size(); ++trigger) {
+        uint32_t state = 0;
+        for (char c : phrases[trigger]) {
+            uint32_t& target = next[state * columns + automaton.classes[static_cast<unsigned char>(c)]];
+            if (target == none) {
+                target = static_cast<uint32_t>(automaton.matches.size());
+                automaton.matches.emplace_back();
+                next.resize(next.size() + columns, none);
+            }
+            state = next[state * columns + automaton.classes[static_cast<unsigned char>(c)]];
+        }
+        automaton.matches[state].push_back(trigger);
+    }
+
+    // breadth first, so a state's failure state is finished before the state itself
+    const uint32_t stateCount = static_cast<uint32_t>(automaton.matches.size());
+    vector<uint32_t> failure(stateCount, 0);
+    vector<uint32_t> queue = { 0 };
+    automaton.transitions.assign(static_cast<size_t>(stateCount) * columns, 0);
+    for (size_t head = 0; head < queue.size(); ++head) {
+        const uint32_t state = queue[head];
+        for (uint32_t column = 0; column < columns; ++column) {
+            uint32_t& transition = automaton.transitions[state * columns + column];
+            const uint32_t child = column == 1 ? none : next[state * columns + column];
+            if (column == 1) {
+                transition = state;                                 // line breaks are skipped
+            }
+            else if (child == none) {
+                transition = state == 0 ? 0 : automaton.transitions[failure[state] * columns + column];
+            }
+            else {
+                failure[child] = state == 0 ? 0 : automaton.transitions[failure[state] * columns + column];
+                const vector<uint32_t>& inherited = automaton.matches[failure[child]];
+                automaton.matches[child].insert(automaton.matches[child].end(), inherited.begin(), inherited.end());
+                transition = child;
+                queue.push_back(child);
+            }
+        }
+    }
+    return automaton;
+}
+
+// string table with every distinct string stored once
+class StringTable {
+public:
+    StringRef add(const string& text) {
+        auto existing = offsets.find(text);
+        if (existing != offsets.end()) {
+            return { existing->second, static_cast<uint32_t>(text.size()) };
+        }
+        uint32_t offset = static_cast<uint32_t>(bytes.size());
+        bytes += text;
+        offsets.emplace(text, offset);
+        return { offset, static_cast<uint32_t>(text.size()) };
+    }
+    const string& data() const { return bytes; }
+
+private:
+    string bytes;
+    unordered_map<string, uint32_t> offsets;
+};
+
+template <typename Record>
+void writeRecords(ostream& out, const vector<Record>& records) {
+    out.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(Record));
+}
+
+// lays the narrative out as described in NarrativeFormat.h (font is null without --font: no layouts)
+string serialize(const Narrative& narrative, const sf::Font* font) {
+    StringTable strings;
+    vector<SequenceRecord> sequenceRecords;
+    vector<LineRecord> lineRecords;
+    vector<TriggerRecord> triggerRecords;
+    vector<LayoutRecord> layoutRecords;
+    vector<LineChunksRecord> lineChunksRecords;
+    vector<StringRef> chunkRecords;
+    vector<AutomatonRecord> automatonRecords;
+    vector<uint32_t> classRecords;
+    vector<StateRecord> stateRecords;
+    vector<uint32_t> transitionRecords;
+    vector<uint32_t> matchRecords;
+
+    for (const Sequence& sequence : narrative.sequences) {
+        sequenceRecords.push_back({ strings.add(sequence.name), static_cast<uint32_t>(lineRecords.size()),
+            static_cast<uint32_t>(sequence.lines.size()) });
+        for (const Line& line : sequence.lines) {
+            lineRecords.push_back({ line.speaker, strings.add(line.text) });
+        }
+    }
+    for (const Trigger& trigger : narrative.triggers) {
+        triggerRecords.push_back({ strings.add(trigger.chapter), strings.add(trigger.phrase), strings.add(trigger.imagePath) });
+    }
+
+    // scripts are parsed one chapter at a time, so a chapter's triggers are next to each other
+    for (size_t first = 0; first < narrative.triggers.size();) {
+        const string& chapter = narrative.triggers[first].chapter;
+        vector<string> phrases;
+        size_t end = first;
+        for (; end < narrative.triggers.size() && narrative.triggers[end].chapter == chapter; ++end) {
+            phrases.push_back(narrative.triggers[end].phrase);
+        }
+
+        Automaton automaton = buildAutomaton(phrases);
+        const uint32_t stateCount = static_cast<uint32_t>(automaton.matches.size());
+        automatonRecords.push_back({ strings.add(chapter), static_cast<uint32_t>(first), static_cast<uint32_t>(phrases.size()),
+            static_cast<uint32_t>(classRecords.size()), automaton.columnCount, static_cast<uint32_t>(stateRecords.size()),
+            stateCount, static_cast<uint32_t>(transitionRecords.size()) });
+        classRecords.insert(classRecords.end(), automaton.classes.begin(), automaton.classes.end());
+        transitionRecords.insert(transitionRecords.end(), automaton.transitions.begin(), automaton.transitions.end());
+        for (const vector<uint32_t>& matches : automaton.matches) {
+            stateRecords.push_back({ static_cast<uint32_t>(matchRecords.size()), static_cast<uint32_t>(matches.size()) });
+            matchRecords.insert(matchRecords.end(), matches.begin(), matches.end());
+        }
+        first = end;
+    }
+
+    if (font) {
+        vector<string> chunks;
+        string wrapped;
+        for (const sf::Vector2u& size : standardSizes) {
+            TextWrap::BoxMetrics box = TextWrap::getBoxMetrics(size);
+            layoutRecords.push_back({ size.x, size.y, box.characterSize, static_cast<uint32_t>(lineChunksRecords.size()) });
+            for (const Sequence& sequence : narrative.sequences) {
+                for (const Line& line : sequence.lines) {
+                    TextWrap::wrap(line.text, *font, box, chunks, wrapped);
+                    lineChunksRecords.push_back({ static_cast<uint32_t>(chunkRecords.size()), static_cast<uint32_t>(chunks.size()) });
+                    for (const string& chunk : chunks) {
+                        chunkRecords.push_back(strings.add(chunk));
+                    }
+                }
+            }
+        }
+    }
+
+    Header header;
+    header.magic = magic;
+    header.version = version;
+    header.sequenceCount = static_cast<uint32_t>(sequenceRecords.size());
+    header.lineCount = static_cast<uint32_t>(lineRecords.size());
+    header.triggerCount = static_cast<uint32_t>(triggerRecords.size());
+    header.layoutCount = static_cast<uint32_t>(layoutRecords.size());
+    header.chunkCount = static_cast<uint32_t>(chunkRecords.size());
+    header.automatonCount = static_cast<uint32_t>(automatonRecords.size());
+    header.classCount = static_cast<uint32_t>(classRecords.size());
+    header.stateCount = static_cast<uint32_t>(stateRecords.size());
+    header.transitionCount = static_cast<uint32_t>(transitionRecords.size());
+    header.matchCount = static_cast<uint32_t>(matchRecords.size());
+
+    ostringstream records;
+    writeRecords(records, sequenceRecords);
+    writeRecords(records, lineRecords);
+    writeRecords(records, triggerRecords);
+    writeRecords(records, layoutRecords);
+    writeRecords(records, lineChunksRecords);
+    writeRecords(records, chunkRecords);
+    writeRecords(records, automatonRecords);
+    writeRecords(records, classRecords);
+    writeRecords(records, stateRecords);
+    writeRecords(records, transitionRecords);
+    writeRecords(records, matchRecords);
+    header.stringTableOffset = static_cast<uint32_t>(sizeof(Header) + records.tellp());
+    header.stringTableSize = static_cast<uint32_t>(strings.data().size());
+
+    string blob(reinterpret_cast<const char*>(&header), sizeof(header));
+    return blob + records.str() + strings.data();
+}
+
+// lays the banks out as described in QuestionFormat.h
+string serializeQuestions(const Narrative& narrative) {
+    StringTable strings;
+    vector<QuestionFormat::BankRecord> bankRecords;
+    vector<QuestionFormat::QuestionRecord> questionRecords;
+    vector<StringRef> optionRecords;
+
+    for (const Bank& bank : narrative.banks) {
+        bankRecords.push_back({ strings.add(bank.name), static_cast<uint32_t>(questionRecords.size()),
+            static_cast<uint32_t>(bank.questions.size()) });
+        for (const Question& question : bank.questions) {
+            questionRecords.push_back({ strings.add(question.text), static_cast<uint32_t>(optionRecords.size()),
+                static_cast<uint32_t>(question.options.size()), static_cast<uint32_t>(question.correctOption) });
+            for (const string& option : question.options) {
+                optionRecords.push_back(strings.add(option));
+            }
+        }
+    }
+
+    ostringstream body;
+    writeRecords(body, bankRecords);
+    writeRecords(body, questionRecords);
+    writeRecords(body, optionRecords);
+    body << strings.data();
+    const string records = body.str();
+
+    QuestionFormat::Header header;
+    header.magic = QuestionFormat::magic;
+    header.version = QuestionFormat::version;
+    header.bankCount = static_cast<uint32_t>(bankRecords.size());
+    header.questionCount = static_cast<uint32_t>(questionRecords.size());
+    header.optionCount = static_cast<uint32_t>(optionRecords.size());
+    header.contentHash = QuestionFormat::hash(records.data(), records.size());
+    header.stringTableOffset = static_cast<uint32_t>(sizeof(header) + records.size() - strings.data().size());
+    header.stringTableSize = static_cast<uint32_t>(strings.data().size());
+
+    string blob(reinterpret_cast<const char*>(&header), sizeof(header));
+    return blob + records;
+}
+
+// written next to the output and renamed over it, so the game never maps a half-written file
+// an output that already holds these bytes is left alone (the .bin files are tracked, a build mustn't touch them)
+bool writeAtomically(const fs::path& outputPath, const string& blob) {
+    {
+        ifstream existing(outputPath, ios::binary);
+        if (existing && string(istreambuf_iterator<char>(existing), istreambuf_iterator<char>()) == blob) {
+            return true;
+        }
+    }
+
+    fs::path temporaryPath = outputPath;
+    temporaryPath += ".tmp";
+    {
+        ofstream out(temporaryPath, ios::binary | ios::trunc);
+        out.write(blob.data(), blob.size());
+        if (!out) {
+            cerr << "can't write " << temporaryPath.string() << "\n";
+            return false;
+        }
+    }
+    error_code error;
+    fs::rename(temporaryPath, outputPath, error);
+    if (error) {
+        cerr << "can't replace " << outputPath.string() << ": " << error.message() << "\n";
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    string fontPath, questionsPath;
+    bool validArguments = argc >= 3 && argc % 2 == 1;
+    for (int i = 3; validArguments && i + 1 < argc; i += 2) {
+        string option = argv[i];
+        if (option == "--font") fontPath = argv[i + 1];
+        else if (option == "--questions") questionsPath = argv[i + 1];
+        else validArguments = false;
+    }
+    if (!validArguments) {
+        cerr << "usage: NarrativeCompiler <script directory> <output file> [--font font.ttf] [--questions questions.bin]\n";
+        return 2;
+    }
+    fs::path scriptDirectory = argv[1];
+    fs::path outputPath = argv[2];
+    bool hasFont = !fontPath.empty();
+
+    sf::Font font;
+    if (hasFont && !font.loadFromFile(fontPath)) {
+        cerr << "can't load font " << fontPath << "\n";
+        return 2;
+    }
+
+    vector<fs::path> scripts, quizzes;
+    error_code error;
+    for (const auto& entry : fs::directory_iterator(scriptDirectory, error)) {
+        if (entry.path().extension() == ".story") scripts.push_back(entry.path());
+        if (entry.path().extension() == ".quiz") quizzes.push_back(entry.path());
+    }
+    if (error || scripts.empty()) {
+        cerr << "no .story scripts in " << scriptDirectory.string() << "\n";
+        return 2;
+    }
+    sort(scripts.begin(), scripts.end());  // same input, same bytes
+    sort(quizzes.begin(), quizzes.end());
+
+    Narrative narrative;
+    for (const fs::path& script : scripts) {
+        parseScript(script, narrative);
+    }
+    for (const fs::path& quiz : quizzes) {
+        parseQuiz(quiz, narrative);
+    }
+    checkTriggers(narrative);
+    checkBanks(narrative);
+    if (!narrative.errors.empty()) {
+        for (const string& message : narrative.errors) {
+            cerr << message << "\n";
+        }
+        return 1;
+    }
+
+    string blob = serialize(narrative, hasFont ? &font : nullptr);
+    if (!writeAtomically(outputPath, blob)) return 2;
+
+    size_t lineCount = 0;
+    for (const Sequence& sequence : narrative.sequences) lineCount += sequence.lines.size();
+    cout << outputPath.string() << ": " << scripts.size() << " chapters, " << narrative.sequences.size()
+        << " sequences, " << lineCount << " lines, " << narrative.triggers.size() << " triggers, "
+        << (hasFont ? size(standardSizes) : 0) << " layouts, " << blob.size() << " bytes\n";
+
+    if (!questionsPath.empty()) {
+        string questions = serializeQuestions(narrative);
+        if (!writeAtomically(questionsPath, questions)) return 2;
+
+        size_t questionCount = 0;
+        for (const Bank& bank : narrative.banks) questionCount += bank.questions.size();
+        cout << questionsPath << ": " << narrative.banks.size() << " banks, " << questionCount << " questions, "
+            << questions.size() << " bytes\n";
+    }
+    return 0;
+}